@@ -8,6 +8,17 @@
 #include <memory>
 #include <unordered_map>
 #include <ctime>
+#include <chrono>
+#include <climits>
+#include <queue>
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include "Money.h"
+#include "PasswordHash.h"
+#include "WriteAheadLog.h"
 
 // --- Transaction Class ---
 // Represents a single banking or trading transaction
@@ -16,17 +27,30 @@ class Transaction {
 public:
     enum Type { DEPOSIT, WITHDRAWAL, STOCK_PURCHASE, STOCK_SALE, FEE };
     
-    Transaction(Type type, double amount, const std::string& description, int day)
-        : type_(type), amount_(amount), description_(description), day_(day) {
-        time_t now = time(0);
-        timestamp_ = ctime(&now);
-    }
+    // Stamped with the wall clock in microseconds since the epoch. Reading the
+    // clock is a vDSO call and the stamp is formatted only when asked for.
+    Transaction(Type type, Money amount, const std::string& description, int day)
+        : type_(type), amount_(amount), description_(description), day_(day),
+          timestamp_(std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::system_clock::now().time_since_epoch()).count()) {}
+    
+    // With a known timestamp (rebuilding a stored transaction)
+    Transaction(Type type, Money amount, const std::string& description, int day, int64_t timestamp)
+        : type_(type), amount_(amount), description_(description), day_(day), timestamp_(timestamp) {}
     
     Type getType() const { return type_; }
-    double getAmount() const { return amount_; }
-    std::string getDescription() const { return description_; }
+    Money getAmount() const { return amount_; }
+    const std::string& getDescription() const { return description_; }
     int getDay() const { return day_; }
-    std::string getTimestamp() const { return timestamp_; }
+    int64_t getTimestampMicros() const { return timestamp_; }
+    std::string getTimestamp() const { return formatTimestamp(timestamp_); }
+    
+    // Local time in ctime() format, e.g. "Wed Jun 30 21:49:08 1993\n"
+    static std::string formatTimestamp(int64_t micros) {
+        time_t seconds = (time_t)(micros / 1000000);
+        char buffer[32];
+        return ctime_r(&seconds, buffer);  // reentrant: banks may run on several threads
+    }
     
     std::string getTypeString() const {
         switch(type_) {
@@ -41,106 +65,665 @@ public:
     
 private:
     Type type_;
-    double amount_;
+    Money amount_;
     std::string description_;
     int day_;
-    std::string timestamp_;
+    int64_t timestamp_;  // microseconds since the epoch
 };
 
-// --- Scheduled Deposit Class ---
-// Represents a future deposit scheduled for a specific day
+// --- Scheduled Transfer Class ---
+// A deposit or withdrawal scheduled for a future day, optionally repeating
+// every `interval` days through `endDay`. Only the next due day is stored, so a
+// rule takes the same space however many times it repeats.
 
-class ScheduledDeposit {
+class ScheduledTransfer {
 public:
-    ScheduledDeposit(int day, double amount, const std::string& description)
-        : scheduledDay_(day), amount_(amount), description_(description), executed_(false) {}
+    enum Kind { DEPOSIT, WITHDRAWAL };
     
-    int getScheduledDay() const { return scheduledDay_; }
-    double getAmount() const { return amount_; }
+    // One-off transfer on `day`
+    ScheduledTransfer(int day, Money amount, const std::string& description, Kind kind = DEPOSIT)
+        : ScheduledTransfer(day, amount, description, kind, 0, day) {}
+    
+    // Every `interval` days from `firstDay` through `endDay` (interval 0 = once)
+    ScheduledTransfer(int firstDay, Money amount, const std::string& description, Kind kind,
+                      int interval, int endDay)
+        : scheduledDay_(firstDay), nextDay_(firstDay), interval_(interval < 0 ? 0 : interval),
+          endDay_(endDay), kind_(kind), amount_(amount), description_(description),
+          executedCount_(0), missedCount_(0) {
+        if (nextDay_ > endDay_) nextDay_ = INT_MAX;
+    }
+    
+    int getScheduledDay() const { return scheduledDay_; }  // first occurrence
+    int getNextDay() const { return nextDay_; }            // INT_MAX once finished
+    int getInterval() const { return interval_; }
+    int getEndDay() const { return endDay_; }
+    Kind getKind() const { return kind_; }
+    bool isRecurring() const { return interval_ > 0; }
+    Money getAmount() const { return amount_; }
     std::string getDescription() const { return description_; }
-    bool isExecuted() const { return executed_; }
-    void markExecuted() { executed_ = true; }
+    int getExecutedCount() const { return executedCount_; }
+    int getMissedCount() const { return missedCount_; }  // withdrawals skipped for lack of funds
+    bool isExecuted() const { return nextDay_ == INT_MAX; }  // no occurrences left
+    
+    // Put a copy back where a checkpointed rule had got to
+    void restoreProgress(int nextDay, int executedCount, int missedCount) {
+        nextDay_ = nextDay;
+        executedCount_ = executedCount;
+        missedCount_ = missedCount;
+    }
+    
+    // Record the due occurrence as done (or missed) and move on to the next one
+    void completeOccurrence(bool executed) {
+        if (executed) executedCount_++;
+        else missedCount_++;
+        
+        if (interval_ == 0 || nextDay_ > endDay_ - interval_) {
+            nextDay_ = INT_MAX;
+        } else {
+            nextDay_ += interval_;
+        }
+    }
     
 private:
     int scheduledDay_;
-    double amount_;
+    int nextDay_;
+    int interval_;
+    int endDay_;
+    Kind kind_;
+    Money amount_;
     std::string description_;
-    bool executed_;
+    int executedCount_;
+    int missedCount_;
+};
+
+// --- Transaction Ledger ---
+// Append-only transaction store. Entries are fixed-size records kept in chunks
+// of kChunkSize that are never moved once allocated, so an append is O(1) and
+// never copies older entries. Descriptions are interned: each distinct text
+// ("Buy NVDA", "Sell GOOG", ...) is stored once and entries refer to it by id.
+// Not synchronized; UserAccount guards its ledger with the history mutex.
+
+class TransactionLedger {
+public:
+    static const size_t kChunkSize = 4096;
+    
+    TransactionLedger() : size_(0), dayOrdered_(true) {}
+    
+    TransactionLedger(const TransactionLedger&) = delete;
+    TransactionLedger& operator=(const TransactionLedger&) = delete;
+    
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    
+    void append(const Transaction& transaction) {
+        if (size_ == chunks_.size() * kChunkSize) {
+            chunks_.push_back(std::unique_ptr<Entry[]>(new Entry[kChunkSize]));
+        }
+        
+        if (size_ > 0 && transaction.getDay() < dayAt(size_ - 1)) {
+            dayOrdered_ = false;
+        }
+        
+        Entry& entry = chunks_[size_ / kChunkSize][size_ % kChunkSize];
+        entry.amount = transaction.getAmount().micros();
+        entry.timestamp = transaction.getTimestampMicros();
+        entry.day = transaction.getDay();
+        entry.description = intern(transaction.getDescription());
+        entry.type = transaction.getType();
+        size_++;
+    }
+    
+    // Rebuild the transaction at `index` (0 = oldest)
+    Transaction at(size_t index) const {
+        const Entry& entry = chunks_[index / kChunkSize][index % kChunkSize];
+        return Transaction(entry.type, Money::fromMicros(entry.amount),
+                           *descriptions_[entry.description], entry.day, entry.timestamp);
+    }
+    
+    int dayAt(size_t index) const {
+        return chunks_[index / kChunkSize][index % kChunkSize].day;
+    }
+    
+    // True while entries were appended in non-decreasing day order (the usual case)
+    bool isDayOrdered() const { return dayOrdered_; }
+    
+    // First index whose day is >= `day`. Binary search when the ledger is in day
+    // order; otherwise 0, and callers check each entry's day.
+    size_t lowerBoundDay(int day) const {
+        if (!dayOrdered_) return 0;
+        
+        size_t low = 0, high = size_;
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (dayAt(mid) < day) low = mid + 1;
+            else high = mid;
+        }
+        return low;
+    }
+    
+    size_t getDescriptionCount() const { return descriptions_.size(); }
+    
+    void clear() {
+        chunks_.clear();
+        size_ = 0;
+        dayOrdered_ = true;
+        descriptions_.clear();
+        descriptionIds_.clear();
+    }
+    
+    struct Entry {
+        int64_t amount;       // Money micro-units
+        int64_t timestamp;    // microseconds since the epoch
+        int32_t day;
+        uint32_t description; // index into the description table
+        Transaction::Type type;
+    };
+    
+    // Raw contents (description table and entries), for checkpoints
+    void exportTo(std::vector<std::string>& descriptions, std::vector<Entry>& entries) const {
+        descriptions.clear();
+        descriptions.reserve(descriptions_.size());
+        for (const std::string* description : descriptions_) {
+            descriptions.push_back(*description);
+        }
+        
+        entries.clear();
+        entries.reserve(size_);
+        for (size_t start = 0; start < size_; start += kChunkSize) {
+            const Entry* chunk = chunks_[start / kChunkSize].get();
+            entries.insert(entries.end(), chunk, chunk + std::min(kChunkSize, size_ - start));
+        }
+    }
+    
+    // Replace the contents with exported entries whose description ids index `descriptions`
+    void assign(const std::vector<std::string>& descriptions, const Entry* entries, size_t count) {
+        clear();
+        
+        std::vector<uint32_t> ids;
+        ids.reserve(descriptions.size());
+        for (const auto& description : descriptions) {
+            ids.push_back(intern(description));
+        }
+        
+        chunks_.reserve((count + kChunkSize - 1) / kChunkSize);
+        for (size_t i = 0; i < count; i++) {
+            if (i % kChunkSize == 0) {
+                chunks_.push_back(std::unique_ptr<Entry[]>(new Entry[kChunkSize]));
+            }
+            Entry& entry = chunks_.back()[i % kChunkSize];
+            entry = entries[i];
+            entry.description = entry.description < ids.size() ? ids[entry.description] : intern("");
+            if (i > 0 && entry.day < entries[i - 1].day) dayOrdered_ = false;
+        }
+        size_ = count;
+    }
+    
+private:
+    uint32_t intern(const std::string& description) {
+        auto it = descriptionIds_.find(description);
+        if (it != descriptionIds_.end()) return it->second;
+        
+        uint32_t id = (uint32_t)descriptions_.size();
+        it = descriptionIds_.emplace(description, id).first;
+        descriptions_.push_back(&it->first);  // map nodes don't move, so the key stays put
+        return id;
+    }
+    
+    std::vector<std::unique_ptr<Entry[]>> chunks_;
+    size_t size_;
+    bool dayOrdered_;
+    std::unordered_map<std::string, uint32_t> descriptionIds_;
+    std::vector<const std::string*> descriptions_;
+};
+
+// --- Settlement ---
+// One leg of a batch settlement. Positive amounts credit the account,
+// negative amounts debit it.
+
+struct Settlement {
+    Transaction::Type type;
+    Money amount;    // positive credits, negative debits
+    std::string description;
+};
+
+// --- Account Snapshot ---
+// Everything needed to recreate an account, for checkpoints.
+
+struct AccountSnapshot {
+    std::string username;
+    PasswordHash password;
+    Money balance;
+    std::vector<std::string> descriptions;           // history description table
+    std::vector<TransactionLedger::Entry> entries;   // history, oldest first
+    std::vector<ScheduledTransfer> scheduledTransfers;
 };
 
 // --- User Account Class ---
-// Stores individual user data, balance, and transaction history
+// Stores individual user data, balance, and transaction history.
+// Balances are Money micro-units held in atomics and are updated with CAS loops,
+// so deposits, withdrawals and settlements never take a lock. Transactions are
+// pushed onto a lock-free per-account queue and moved into the ledger in
+// batches, so balance updates don't wait behind history appends.
+// Scheduled transfers are not atomic; BankingSystem guards them with the shard lock.
+// When BankingSystem has a journal, every balance change is also appended to it,
+// and once the journal has failed balance changes are refused.
 
 class UserAccount {
 public:
-    UserAccount(const std::string& username, const std::string& password, 
-                double initialBalance = 10000.0)
-        : username_(username), password_(password), balance_(initialBalance) {}
+    UserAccount(const std::string& username, const PasswordHash& password, 
+                Money initialBalance = Money::units(10000))
+        : username_(username), password_(password), balance_(initialBalance.micros()),
+          pendingLog_(nullptr), journal_(nullptr), journalId_(0) {}
+    
+    ~UserAccount() {
+        drainLog();
+    }
+    
+    UserAccount(const UserAccount&) = delete;
+    UserAccount& operator=(const UserAccount&) = delete;
     
     // Getters
     std::string getUsername() const { return username_; }
-    double getBalance() const { return balance_; }
-    std::vector<Transaction> getTransactionHistory() const { return transactionHistory_; }
-    std::vector<ScheduledDeposit> getScheduledDeposits() const { return scheduledDeposits_; }
+    Money getBalance() const { return Money::fromMicros(balance_.load()); }
+    std::vector<ScheduledTransfer> getScheduledTransfers() const { return scheduledTransfers_; }
+    
+    // --- History queries ---
+    // Each holds the history lock only while it copies out the entries it returns.
+    
+    std::vector<Transaction> getTransactionHistory() const {
+        return getTransactions(0, SIZE_MAX);
+    }
+    
+    size_t getTransactionCount() const {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        drainLog();
+        return ledger_.size();
+    }
+    
+    // Up to `limit` transactions starting at `offset` (0 = oldest)
+    std::vector<Transaction> getTransactions(size_t offset, size_t limit) const {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        drainLog();
+        
+        std::vector<Transaction> page;
+        size_t end = offset + std::min(limit, ledger_.size() - std::min(offset, ledger_.size()));
+        page.reserve(end > offset ? end - offset : 0);
+        for (size_t i = offset; i < end; i++) {
+            page.push_back(ledger_.at(i));
+        }
+        return page;
+    }
+    
+    // The newest `count` transactions, oldest first
+    std::vector<Transaction> getRecentTransactions(size_t count) const {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        drainLog();
+        
+        size_t start = ledger_.size() > count ? ledger_.size() - count : 0;
+        std::vector<Transaction> page;
+        page.reserve(ledger_.size() - start);
+        for (size_t i = start; i < ledger_.size(); i++) {
+            page.push_back(ledger_.at(i));
+        }
+        return page;
+    }
+    
+    // Transactions on days fromDay..toDay inclusive, at most `limit` of them
+    std::vector<Transaction> getTransactionsByDay(int fromDay, int toDay, size_t limit = SIZE_MAX) const {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        drainLog();
+        
+        std::vector<Transaction> page;
+        for (size_t i = ledger_.lowerBoundDay(fromDay); i < ledger_.size() && page.size() < limit; i++) {
+            int day = ledger_.dayAt(i);
+            if (day > toDay && ledger_.isDayOrdered()) break;
+            if (day >= fromDay && day <= toDay) {
+                page.push_back(ledger_.at(i));
+            }
+        }
+        return page;
+    }
+    
+    // Stream the whole history, oldest first, to visit(const Transaction&).
+    // Entries are copied out `batchSize` at a time and visited without the lock
+    // held, so appends carry on while a long export runs.
+    template <typename Visitor>
+    void visitTransactions(Visitor visit, size_t batchSize = 256) const {
+        for (size_t offset = 0; ; offset += batchSize) {
+            std::vector<Transaction> batch = getTransactions(offset, batchSize);
+            for (const auto& transaction : batch) {
+                visit(transaction);
+            }
+            if (batch.size() < batchSize) break;
+        }
+    }
     
     // Banking operations
-    bool deposit(double amount, const std::string& description, int day) {
-        if (amount <= 0) return false;
+    bool deposit(Money amount, const std::string& description, int day) {
+        if (amount <= Money() || journalFailed()) return false;
+        
+        balance_.fetch_add(amount.micros());
+        logTransaction(Transaction(Transaction::DEPOSIT, amount, description, day), amount.micros());
+        return true;
+    }
+    
+    bool withdraw(Money amount, const std::string& description, int day) {
+        if (amount <= Money() || journalFailed() || !debit(amount.micros())) return false;
         
-        balance_ += amount;
-        transactionHistory_.push_back(Transaction(Transaction::DEPOSIT, amount, description, day));
+        logTransaction(Transaction(Transaction::WITHDRAWAL, amount, description, day), -amount.micros());
         return true;
     }
     
-    bool withdraw(double amount, const std::string& description, int day) {
-        if (amount <= 0 || balance_ < amount) return false;
+    // Apply every entry in order, or none of them if any debit would overdraw
+    // the balance at its point in the batch. The whole batch is one CAS:
+    // it needs the balance to cover the deepest point the running total reaches.
+    bool settleBatch(const std::vector<Settlement>& batch, int day) {
+        if (journalFailed()) return false;
         
-        balance_ -= amount;
-        transactionHistory_.push_back(Transaction(Transaction::WITHDRAWAL, amount, description, day));
+        int64_t net = 0;
+        int64_t needed = 0;
+        for (const auto& entry : batch) {
+            net += entry.amount.micros();
+            needed = std::max(needed, -net);
+        }
+        
+        int64_t current = balance_.load();
+        do {
+            if (current < needed) return false;
+        } while (!balance_.compare_exchange_weak(current, current + net));
+        
+        for (const auto& entry : batch) {
+            Money amount = entry.amount < Money() ? -entry.amount : entry.amount;
+            logTransaction(Transaction(entry.type, amount, entry.description, day), entry.amount.micros());
+        }
         return true;
     }
     
     // Password verification
     bool verifyPassword(const std::string& password) const {
-        return password_ == password;
+        return password_.matches(password);
     }
     
-    // Schedule a deposit for a future day
-    void scheduleDeposit(int day, double amount, const std::string& description) {
-        scheduledDeposits_.push_back(ScheduledDeposit(day, amount, description));
+    // Store a transfer rule and return its index in getScheduledTransfers().
+    // BankingSystem's scheduler decides when it runs.
+    size_t scheduleTransfer(const ScheduledTransfer& transfer) {
+        scheduledTransfers_.push_back(transfer);
+        return scheduledTransfers_.size() - 1;
     }
     
-    // Execute scheduled deposits for the current day
-    int executeScheduledDeposits(int currentDay) {
-        int executed = 0;
-        for (auto& scheduled : scheduledDeposits_) {
-            if (!scheduled.isExecuted() && scheduled.getScheduledDay() == currentDay) {
-                if (deposit(scheduled.getAmount(), scheduled.getDescription(), currentDay)) {
-                    scheduled.markExecuted();
-                    executed++;
-                }
-            }
-        }
+    // Run the due occurrence of a rule. `epoch` is getScheduleEpoch() from when it
+    // was scheduled; a reset since then cancels it. A withdrawal the balance can't
+    // cover is skipped. Sets nextDay to the rule's following occurrence (INT_MAX if none).
+    bool executeScheduledTransfer(size_t index, uint64_t epoch, int currentDay, int& nextDay) {
+        nextDay = INT_MAX;
+        if (epoch != scheduleEpoch_ || index >= scheduledTransfers_.size()) return false;
+        
+        ScheduledTransfer& scheduled = scheduledTransfers_[index];
+        if (scheduled.isExecuted()) return false;
+        
+        bool executed = (scheduled.getKind() == ScheduledTransfer::DEPOSIT)
+            ? deposit(scheduled.getAmount(), scheduled.getDescription(), currentDay)
+            : withdraw(scheduled.getAmount(), scheduled.getDescription(), currentDay);
+        
+        scheduled.completeOccurrence(executed);
+        nextDay = scheduled.getNextDay();
         return executed;
     }
     
+    uint64_t getScheduleEpoch() const { return scheduleEpoch_; }
+    
     // Reset account for new simulation
-    void reset(double initialBalance = 10000.0) {
-        balance_ = initialBalance;
-        transactionHistory_.clear();
-        scheduledDeposits_.clear();
+    bool reset(Money initialBalance = Money::units(10000)) {
+        if (journalFailed()) return false;
+        
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        balance_.store(initialBalance.micros());
+        drainLog();
+        ledger_.clear();
+        scheduledTransfers_.clear();
+        scheduleEpoch_++;
+        
+        if (journal_) {
+            journal_->append({JournalRecord::RESET, journalId_, initialBalance.micros(), 0, 0, 0, {}, {}, {}});
+        }
+        return true;
+    }
+    
+    // --- Journal ---
+    
+    // Start journaling balance changes under `id`. Set up once, before the
+    // account is shared with other threads.
+    void attachJournal(WriteAheadLog* journal, uint32_t id) {
+        journal_ = journal;
+        journalId_ = id;
+    }
+    
+    uint32_t getJournalId() const { return journalId_; }
+    
+    // A change now could no longer be made durable
+    bool journalFailed() const { return journal_ && journal_->hasFailed(); }
+    
+    // ACCOUNT record that recreates this account with `balance`
+    JournalRecord openingRecord(Money balance) const {
+        return {JournalRecord::ACCOUNT, journalId_, balance.micros(), 0, 0, 0, username_, password_.bytes(), {}};
+    }
+    
+    // Apply a journaled change during recovery, before attachJournal(): adjust the
+    // balance by `change` (zero for history-only entries) and add the transaction
+    void restoreTransaction(const Transaction& transaction, Money change) {
+        balance_.fetch_add(change.micros());
+        logTransaction(transaction, change.micros());
+    }
+    
+    // --- Checkpoints ---
+    // Scheduled transfers are read and replaced too, so the shard lock must be held.
+    
+    AccountSnapshot snapshot() const {
+        AccountSnapshot state;
+        state.username = username_;
+        state.password = password_;
+        state.balance = getBalance();
+        {
+            std::lock_guard<std::mutex> lock(historyMutex_);
+            drainLog();
+            ledger_.exportTo(state.descriptions, state.entries);
+        }
+        state.scheduledTransfers = scheduledTransfers_;
+        return state;
+    }
+    
+    // Replace balance, history and scheduled transfers with a snapshot's. Transfers
+    // queued before are cancelled; BankingSystem queues the snapshot's again.
+    void restore(const AccountSnapshot& state) {
+        std::lock_guard<std::mutex> lock(historyMutex_);
+        balance_.store(state.balance.micros());
+        drainLog();
+        ledger_.assign(state.descriptions, state.entries.data(), state.entries.size());
+        scheduledTransfers_ = state.scheduledTransfers;
+        scheduleEpoch_++;
+    }
+    
+    // Write this account's state as journal records: the account with its
+    // current balance, then its history
+    template <typename WriteRecord>
+    void writeJournalState(WriteRecord writeRecord) const {
+        writeRecord(openingRecord(getBalance()));
+        visitTransactions([&](const Transaction& transaction) {
+            writeRecord(JournalRecord{JournalRecord::HISTORY, journalId_, transaction.getAmount().micros(),
+                               (uint8_t)transaction.getType(), transaction.getDay(),
+                               transaction.getTimestampMicros(), {}, {}, transaction.getDescription()});
+        });
     }
     
 private:
+    // --- Fixed-point balance ---
+    
+    // Take `amount` from the available balance unless that would overdraw it
+    bool debit(int64_t amount) {
+        int64_t current = balance_.load();
+        do {
+            if (current < amount) return false;
+        } while (!balance_.compare_exchange_weak(current, current - amount));
+        return true;
+    }
+    
+    // --- Transaction log queue ---
+    
+    struct LogNode {
+        Transaction transaction;
+        LogNode* next;
+    };
+    
+    // Lock-free push; any thread may log. `change` is the signed balance change
+    // the transaction made, for the journal.
+    void logTransaction(Transaction transaction, int64_t change) {
+        if (journal_) {
+            journal_->append({JournalRecord::TRANSACTION, journalId_, change, (uint8_t)transaction.getType(),
+                              transaction.getDay(), transaction.getTimestampMicros(),
+                              {}, {}, transaction.getDescription()});
+        }
+        
+        LogNode* node = new LogNode{std::move(transaction), pendingLog_.load(std::memory_order_relaxed)};
+        while (!pendingLog_.compare_exchange_weak(node->next, node,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed)) {
+        }
+        
+        // Move a full batch into the compact ledger now, unless someone else holds
+        // the history lock (they will drain it), so accounts nobody reads stay small
+        if (pendingCount_.fetch_add(1, std::memory_order_relaxed) + 1 >= kDrainBatch) {
+            std::unique_lock<std::mutex> lock(historyMutex_, std::try_to_lock);
+            if (lock.owns_lock()) drainLog();
+        }
+    }
+    
+    // Move queued transactions into the ledger, oldest first (historyMutex_ held)
+    void drainLog() const {
+        LogNode* newest = pendingLog_.exchange(nullptr, std::memory_order_acquire);
+        
+        // the queue is newest first; reverse it in place
+        LogNode* oldest = nullptr;
+        while (newest) {
+            LogNode* next = newest->next;
+            newest->next = oldest;
+            oldest = newest;
+            newest = next;
+        }
+        
+        int32_t drained = 0;
+        while (oldest) {
+            LogNode* next = oldest->next;
+            ledger_.append(oldest->transaction);
+            delete oldest;
+            oldest = next;
+            drained++;
+        }
+        pendingCount_.fetch_sub(drained, std::memory_order_relaxed);
+    }
+    
     std::string username_;
-    std::string password_;
-    double balance_;
-    std::vector<Transaction> transactionHistory_;
-    std::vector<ScheduledDeposit> scheduledDeposits_;
+    PasswordHash password_;           // salted hash, never the password itself
+    std::atomic<int64_t> balance_;     // micro-units
+    static const int32_t kDrainBatch = 64;                // queued transactions that trigger a drain
+    mutable std::atomic<LogNode*> pendingLog_;             // newest first
+    mutable std::atomic<int32_t> pendingCount_{0};         // nodes in pendingLog_ (approximate while pushing)
+    mutable TransactionLedger ledger_;                     // oldest first, guarded by historyMutex_
+    mutable std::mutex historyMutex_;
+    std::vector<ScheduledTransfer> scheduledTransfers_;
+    uint64_t scheduleEpoch_ = 0;  // bumped by reset() to cancel queued transfers
+    WriteAheadLog* journal_;      // owned by BankingSystem, null when not journaling
+    uint32_t journalId_;
+};
+
+// --- Account Handle ---
+// Session handle returned by login. Points straight at a UserAccount, so
+// operations skip the username lookup. Balance operations are lock-free; the
+// shard lock is only taken for scheduled deposits and reset. Accounts are never
+// removed, so a handle stays valid for as long as its BankingSystem lives.
+// Handles are cheap to copy and may be used from several threads at once.
+
+class AccountHandle {
+public:
+    AccountHandle() : account_(nullptr), mutex_(nullptr) {}
+    
+    bool isValid() const { return account_ != nullptr; }
+    
+    std::string getUsername() const {
+        return account_ ? account_->getUsername() : "";
+    }
+    
+    bool deposit(Money amount, const std::string& description, int day) {
+        return account_ && account_->deposit(amount, description, day);
+    }
+    
+    bool withdraw(Money amount, const std::string& description, int day) {
+        return account_ && account_->withdraw(amount, description, day);
+    }
+    
+    Money getBalance() const {
+        return account_ ? account_->getBalance() : Money();
+    }
+    
+    // Settle a batch of credits and debits in one atomic update, all or nothing
+    bool settleBatch(const std::vector<Settlement>& batch, int day) {
+        return account_ && account_->settleBatch(batch, day);
+    }
+    
+    std::vector<Transaction> getTransactionHistory() const {
+        if (!account_) return {};
+        return account_->getTransactionHistory();
+    }
+    
+    size_t getTransactionCount() const {
+        return account_ ? account_->getTransactionCount() : 0;
+    }
+    
+    std::vector<Transaction> getTransactions(size_t offset, size_t limit) const {
+        if (!account_) return {};
+        return account_->getTransactions(offset, limit);
+    }
+    
+    std::vector<Transaction> getRecentTransactions(size_t count) const {
+        if (!account_) return {};
+        return account_->getRecentTransactions(count);
+    }
+    
+    std::vector<Transaction> getTransactionsByDay(int fromDay, int toDay, size_t limit = SIZE_MAX) const {
+        if (!account_) return {};
+        return account_->getTransactionsByDay(fromDay, toDay, limit);
+    }
+    
+    template <typename Visitor>
+    void visitTransactions(Visitor visit, size_t batchSize = 256) const {
+        if (account_) account_->visitTransactions(visit, batchSize);
+    }
+    
+    std::vector<ScheduledTransfer> getScheduledTransfers() const {
+        if (!account_) return {};
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return account_->getScheduledTransfers();
+    }
+    
+    bool reset(Money initialBalance = Money::units(10000)) {
+        if (!account_) return false;
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return account_->reset(initialBalance);
+    }
+    
+private:
+    friend class BankingSystem;
+    
+    AccountHandle(UserAccount* account, std::mutex* mutex) : account_(account), mutex_(mutex) {}
+    
+    UserAccount* account_;
+    std::mutex* mutex_;  // lock of the shard that owns the account (scheduled deposits, reset)
 };
 
 // --- Banking System (Singleton Pattern) ---
-// Central system managing all user accounts and banking operations
+// Central system managing all user accounts and banking operations.
+// With openJournal() accounts, balances and histories are kept in a write-ahead
+// log and come back on the next start; scheduled transfers are not journaled.
+// Passwords are kept only as salted hashes (see PasswordHash).
 
 class BankingSystem {
 public:
@@ -150,6 +733,11 @@ public:
         return instance;
     }
     
+    // The GUI shares the singleton above; simulations may also own an
+    // isolated bank so independent runs do not touch each other's accounts.
+    BankingSystem() : currentUser_("") {}
+    ~BankingSystem() = default;
+    
     // Delete copy constructor and assignment operator
     BankingSystem(const BankingSystem&) = delete;
     BankingSystem& operator=(const BankingSystem&) = delete;
@@ -158,167 +746,482 @@ public:
     
     // Register a new user
     bool registerUser(const std::string& username, const std::string& password, 
-                     double initialBalance = 10000.0) {
-        std::lock_guard<std::mutex> lock(mutex_);
+                     Money initialBalance = Money::units(10000)) {
+        if (journal_ && journal_->hasFailed()) return false;
+        
+        Shard& shard = shardFor(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
         // Check if username already exists
-        if (accounts_.find(username) != accounts_.end()) {
+        if (shard.accounts.find(username) != shard.accounts.end()) {
             return false;  // Username taken
         }
         
         // Create new account
-        accounts_[username] = std::make_unique<UserAccount>(username, password, initialBalance);
+        std::unique_ptr<UserAccount>& account = shard.accounts[username];
+        account = std::make_unique<UserAccount>(username, PasswordHash::create(password), initialBalance);
+        if (journal_) {
+            journalAccount(*account, initialBalance);
+        }
         return true;
     }
     
-    // Login
-    bool login(const std::string& username, const std::string& password) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    // Open a session for a user. Returns an invalid handle for unknown users or wrong passwords.
+    // Any number of sessions may be open at once, independent of the logged-in user below.
+    AccountHandle openSession(const std::string& username, const std::string& password) {
+        Shard& shard = shardFor(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
-        // Check if user exists
-        auto it = accounts_.find(username);
-        if (it == accounts_.end()) {
-            return false;  // User not found
-        }
+        auto it = shard.accounts.find(username);
+        if (it == shard.accounts.end()) return AccountHandle();  // User not found
+        
+        if (!it->second->verifyPassword(password)) return AccountHandle();  // Wrong password
+        
+        return AccountHandle(it->second.get(), &shard.mutex);
+    }
+    
+    // Handle to a named account without a password check, for trusted callers
+    // such as trading bots that act for an account they were set up for.
+    AccountHandle getAccount(const std::string& username) {
+        Shard& shard = shardFor(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
-        // Verify password
-        if (!it->second->verifyPassword(password)) {
-            return false;  // Wrong password
+        auto it = shard.accounts.find(username);
+        if (it == shard.accounts.end()) return AccountHandle();
+        
+        return AccountHandle(it->second.get(), &shard.mutex);
+    }
+    
+    // Login
+    bool login(const std::string& username, const std::string& password) {
+        AccountHandle session = openSession(username, password);
+        if (!session.isValid()) {
+            return false;  // User not found or wrong password
         }
         
         // Set as current user
+        std::lock_guard<std::mutex> lock(sessionMutex_);
         currentUser_ = username;
+        currentSession_ = session;
         return true;
     }
     
     // Logout
     void logout() {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(sessionMutex_);
         currentUser_ = "";
+        currentSession_ = AccountHandle();
     }
     
     // Check if someone is logged in
     bool isLoggedIn() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(sessionMutex_);
         return !currentUser_.empty();
     }
     
     // Get current logged-in username
     std::string getCurrentUser() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(sessionMutex_);
         return currentUser_;
     }
     
+    // Session of the logged-in user (invalid when nobody is logged in)
+    AccountHandle getCurrentSession() const {
+        std::lock_guard<std::mutex> lock(sessionMutex_);
+        return currentSession_;
+    }
+    
     // Banking Operations (for currently logged-in user)
+    // These go through the login session, so there is no username lookup per call.
     
     // Deposit money
-    bool deposit(double amount, const std::string& description, int currentDay) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return false;  // Not logged in
-        
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return false;
-        
-        return it->second->deposit(amount, description, currentDay);
+    bool deposit(Money amount, const std::string& description, int currentDay) {
+        return getCurrentSession().deposit(amount, description, currentDay);
     }
     
     // Withdraw money
-    bool withdraw(double amount, const std::string& description, int currentDay) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return false;  // Not logged in
-        
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return false;
-        
-        return it->second->withdraw(amount, description, currentDay);
+    bool withdraw(Money amount, const std::string& description, int currentDay) {
+        return getCurrentSession().withdraw(amount, description, currentDay);
     }
     
     // Get balance of current user
-    double getBalance() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return 0.0;
-        
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return 0.0;
-        
-        return it->second->getBalance();
+    Money getBalance() const {
+        return getCurrentSession().getBalance();
     }
     
     // Get transaction history of current user
     std::vector<Transaction> getTransactionHistory() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return {};
-        
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return {};
+        return getCurrentSession().getTransactionHistory();
+    }
+    
+    // Paged and streaming history of current user; see UserAccount
+    size_t getTransactionCount() const {
+        return getCurrentSession().getTransactionCount();
+    }
+    
+    std::vector<Transaction> getTransactions(size_t offset, size_t limit) const {
+        return getCurrentSession().getTransactions(offset, limit);
+    }
+    
+    std::vector<Transaction> getRecentTransactions(size_t count) const {
+        return getCurrentSession().getRecentTransactions(count);
+    }
+    
+    std::vector<Transaction> getTransactionsByDay(int fromDay, int toDay, size_t limit = SIZE_MAX) const {
+        return getCurrentSession().getTransactionsByDay(fromDay, toDay, limit);
+    }
+    
+    template <typename Visitor>
+    void visitTransactions(Visitor visit, size_t batchSize = 256) const {
+        getCurrentSession().visitTransactions(visit, batchSize);
+    }
+    
+    // Banking Operations (for a named account, no login needed)
+    // Used by per-account trading bots that run alongside the logged-in user.
+    // The shard lock is held only for the lookup; the balance update itself is lock-free.
+    
+    bool depositTo(const std::string& username, Money amount, const std::string& description, int currentDay) {
+        return getAccount(username).deposit(amount, description, currentDay);
+    }
+    
+    bool withdrawFrom(const std::string& username, Money amount, const std::string& description, int currentDay) {
+        return getAccount(username).withdraw(amount, description, currentDay);
+    }
+    
+    Money getBalanceOf(const std::string& username) const {
+        const UserAccount* account = nullptr;
+        {
+            const Shard& shard = shardFor(username);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            
+            auto it = shard.accounts.find(username);
+            if (it == shard.accounts.end()) return Money();
+            account = it->second.get();
+        }
+        return account->getBalance();
+    }
+    
+    bool resetAccount(const std::string& username, Money initialBalance = Money::units(10000)) {
+        Shard& shard = shardFor(username);
+        std::lock_guard<std::mutex> lock(shard.mutex);
         
-        return it->second->getTransactionHistory();
+        auto it = shard.accounts.find(username);
+        return it != shard.accounts.end() && it->second->reset(initialBalance);
     }
     
     // Reset current user's account
-    void resetCurrentAccount(double initialBalance = 10000.0) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return;
-        
-        auto it = accounts_.find(currentUser_);
-        if (it != accounts_.end()) {
-            it->second->reset(initialBalance);
+    bool resetCurrentAccount(Money initialBalance = Money::units(10000)) {
+        return getCurrentSession().reset(initialBalance);
+    }
+    
+    // Scheduled Transfers (all accounts)
+    // Every account's pending transfers sit in one min-heap keyed by due day, so
+    // running a day only touches the transfers due that day. A recurring rule has
+    // one heap entry at a time: after each occurrence it is re-queued for the next.
+    
+    // Schedule a one-off deposit for current user
+    bool scheduleDeposit(int day, Money amount, const std::string& description) {
+        return scheduleTransferFor(getCurrentSession(), ScheduledTransfer(day, amount, description));
+    }
+    
+    // Schedule a one-off deposit for a named account
+    bool scheduleDepositTo(const std::string& username, int day, Money amount, const std::string& description) {
+        return scheduleTransferFor(getAccount(username), ScheduledTransfer(day, amount, description));
+    }
+    
+    // Schedule a (possibly recurring) transfer for current user
+    bool scheduleTransfer(const ScheduledTransfer& transfer) {
+        return scheduleTransferFor(getCurrentSession(), transfer);
+    }
+    
+    bool scheduleTransferTo(const std::string& username, const ScheduledTransfer& transfer) {
+        return scheduleTransferFor(getAccount(username), transfer);
+    }
+    
+    // Execute every account's transfers due on or before currentDay.
+    // Returns the number that went through (skipped withdrawals don't count).
+    int executeScheduledTransfers(int currentDay) {
+        int executed = 0;
+        for (;;) {
+            ScheduledEntry entry;
+            {
+                std::lock_guard<std::mutex> lock(scheduleMutex_);
+                if (schedule_.empty() || schedule_.top().day > currentDay) break;
+                entry = schedule_.top();
+                schedule_.pop();
+            }
+            
+            int nextDay;
+            {
+                std::lock_guard<std::mutex> lock(*entry.mutex);
+                if (entry.account->executeScheduledTransfer(entry.index, entry.epoch, currentDay, nextDay)) {
+                    executed++;
+                }
+            }
+            
+            if (nextDay != INT_MAX) {
+                entry.day = nextDay;
+                enqueue(entry);
+            }
         }
+        return executed;
     }
     
-    // Schedule a deposit for current user
-    bool scheduleDeposit(int day, double amount, const std::string& description) {
-        std::lock_guard<std::mutex> lock(mutex_);
+    // Day of the earliest queued transfer across all accounts (INT_MAX when none)
+    int getNextScheduledDay() const {
+        std::lock_guard<std::mutex> lock(scheduleMutex_);
+        return schedule_.empty() ? INT_MAX : schedule_.top().day;
+    }
+    
+    // Get scheduled transfers for current user
+    std::vector<ScheduledTransfer> getScheduledTransfers() const {
+        return getCurrentSession().getScheduledTransfers();
+    }
+    
+    // Persistence (write-ahead log)
+    
+    // Recover the accounts stored in `directory` and journal every change from
+    // now on. Call once, before any account is registered and before other
+    // threads use the bank. Returns false if the journal can't be opened.
+    bool openJournal(const std::string& directory, const JournalOptions& options = JournalOptions()) {
+        if (journal_) return false;
+        for (const Shard& shard : shards_) {
+            if (!shard.accounts.empty()) return false;
+        }
         
-        if (currentUser_.empty()) return false;
+        std::unique_ptr<WriteAheadLog> journal = std::make_unique<WriteAheadLog>(directory, options);
+        std::vector<UserAccount*> accounts;
+        bool plaintextPasswords = false;
+        if (!journal->open([&](const JournalRecord& record) { restore(record, accounts, plaintextPasswords); })) {
+            for (Shard& shard : shards_) {
+                shard.accounts.clear();
+            }
+            return false;
+        }
         
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return false;
+        for (size_t id = 0; id < accounts.size(); id++) {
+            if (accounts[id]) accounts[id]->attachJournal(journal.get(), (uint32_t)id);
+        }
+        journalAccounts_ = std::move(accounts);
+        journal_ = std::move(journal);
         
-        it->second->scheduleDeposit(day, amount, description);
+        // rewrite an older journal so its plaintext passwords are replaced by hashes
+        if (plaintextPasswords) compactJournal();
         return true;
     }
     
-    // Execute scheduled deposits for current day (for current user)
-    int executeScheduledDeposits(int currentDay) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        if (currentUser_.empty()) return 0;
-        
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return 0;
+    bool isJournaling() const { return journal_ != nullptr; }
+    
+    // Wait until every change so far is on disk. False if the journal has
+    // failed: changes since the failure are lost on restart, and balance
+    // changes are refused from then on.
+    bool syncJournal() {
+        return !journal_ || journal_->sync();
+    }
+    
+    // Write a snapshot of every account and start an empty log, so recovery
+    // doesn't have to replay the whole past. Nothing may change balances while
+    // this runs; call it between trading days.
+    bool compactJournal() {
+        if (!journal_) return false;
         
-        return it->second->executeScheduledDeposits(currentDay);
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        return journal_->compact([this](auto writeRecord) {
+            for (const UserAccount* account : journalAccounts_) {
+                if (account) account->writeJournalState(writeRecord);
+            }
+        });
     }
     
-    // Get scheduled deposits for current user
-    std::vector<ScheduledDeposit> getScheduledDeposits() const {
-        std::lock_guard<std::mutex> lock(mutex_);
+    // Compact once the log has grown past JournalOptions::compactAfterBytes
+    bool compactJournalIfNeeded() {
+        return journal_ && journal_->needsCompaction() && compactJournal();
+    }
+    
+    // Checkpoints
+    
+    // State of every account, in a fixed order (by username)
+    std::vector<AccountSnapshot> captureAccounts() const {
+        std::vector<AccountSnapshot> accounts;
+        for (const Shard& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const auto& entry : shard.accounts) {
+                accounts.push_back(entry.second->snapshot());
+            }
+        }
         
-        if (currentUser_.empty()) return {};
+        std::sort(accounts.begin(), accounts.end(), [](const AccountSnapshot& a, const AccountSnapshot& b) {
+            return a.username < b.username;
+        });
+        return accounts;
+    }
+    
+    // Bring every captured account back to its captured state, registering the
+    // ones that don't exist; other accounts are left alone. Like compactJournal(),
+    // nothing else may be using the accounts meanwhile. Refused once the journal
+    // has failed, as the restored state could not be saved.
+    bool restoreAccounts(const std::vector<AccountSnapshot>& accounts) {
+        if (journal_ && journal_->hasFailed()) return false;
         
-        auto it = accounts_.find(currentUser_);
-        if (it == accounts_.end()) return {};
+        for (const auto& state : accounts) {
+            AccountHandle session;
+            {
+                Shard& shard = shardFor(state.username);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                
+                std::unique_ptr<UserAccount>& account = shard.accounts[state.username];
+                if (!account) {
+                    account = std::make_unique<UserAccount>(state.username, state.password, state.balance);
+                    if (journal_) journalAccount(*account, state.balance);
+                }
+                account->restore(state);
+                session = AccountHandle(account.get(), &shard.mutex);
+            }
+            
+            // queue the transfers that still have occurrences left
+            uint64_t epoch = session.account_->getScheduleEpoch();
+            for (size_t i = 0; i < state.scheduledTransfers.size(); i++) {
+                const ScheduledTransfer& transfer = state.scheduledTransfers[i];
+                if (!transfer.isExecuted()) {
+                    enqueue({transfer.getNextDay(), 0, session.account_, session.mutex_, i, epoch});
+                }
+            }
+        }
         
-        return it->second->getScheduledDeposits();
+        // the journal holds none of this; fold the restored state into a snapshot
+        if (journal_ && !accounts.empty()) return compactJournal();
+        return true;
     }
     
 private:
-    // Private constructor for singleton
-    BankingSystem() : currentUser_("") {}
+    // Accounts are split over independently locked shards by username hash,
+    // so operations on accounts in different shards never contend. Each shard
+    // gets its own cache lines, so neighbouring shards' locks don't false-share.
+    static const size_t kShardCount = 64;
     
-    // Private destructor
-    ~BankingSystem() = default;
+    struct alignas(64) Shard {
+        std::unordered_map<std::string, std::unique_ptr<UserAccount>> accounts;
+        mutable std::mutex mutex;
+    };
+    
+    Shard& shardFor(const std::string& username) {
+        return shards_[std::hash<std::string>()(username) % kShardCount];
+    }
+    
+    const Shard& shardFor(const std::string& username) const {
+        return shards_[std::hash<std::string>()(username) % kShardCount];
+    }
+    
+    // Next occurrence of a scheduled transfer. Entries cancelled by an account
+    // reset stay in the heap until their day and are skipped then.
+    struct ScheduledEntry {
+        int day;
+        uint64_t sequence;    // same-day transfers run in the order they were queued
+        UserAccount* account;
+        std::mutex* mutex;    // shard lock of the account
+        size_t index;         // into the account's scheduled transfers
+        uint64_t epoch;       // account's schedule epoch when scheduled
+    };
+    
+    struct LaterEntry {
+        bool operator()(const ScheduledEntry& a, const ScheduledEntry& b) const {
+            return a.day != b.day ? a.day > b.day : a.sequence > b.sequence;
+        }
+    };
+    
+    bool scheduleTransferFor(const AccountHandle& session, const ScheduledTransfer& transfer) {
+        if (!session.isValid() || transfer.isExecuted()) return false;
+        
+        ScheduledEntry entry;
+        entry.day = transfer.getNextDay();
+        entry.account = session.account_;
+        entry.mutex = session.mutex_;
+        {
+            std::lock_guard<std::mutex> lock(*session.mutex_);
+            entry.index = session.account_->scheduleTransfer(transfer);
+            entry.epoch = session.account_->getScheduleEpoch();
+        }
+        
+        enqueue(entry);
+        return true;
+    }
+    
+    void enqueue(ScheduledEntry entry) {
+        std::lock_guard<std::mutex> lock(scheduleMutex_);
+        entry.sequence = scheduleSequence_++;
+        schedule_.push(entry);
+    }
+    
+    // Give a new account the next journal id and log its opening (shard lock held)
+    void journalAccount(UserAccount& account, Money initialBalance) {
+        std::lock_guard<std::mutex> lock(journalMutex_);
+        uint32_t id = (uint32_t)journalAccounts_.size();
+        journalAccounts_.push_back(&account);
+        account.attachJournal(journal_.get(), id);
+        
+        journal_->append(account.openingRecord(initialBalance));
+    }
+    
+    // Apply one recovered journal record; `accounts` maps journal ids to accounts.
+    // Sets plaintextPasswords for accounts opened by an older log that stored
+    // the password itself.
+    void restore(const JournalRecord& record, std::vector<UserAccount*>& accounts, bool& plaintextPasswords) {
+        if (record.kind == JournalRecord::ACCOUNT || record.kind == JournalRecord::OPEN_ACCOUNT) {
+            std::string username(record.username);
+            Shard& shard = shardFor(username);
+            std::unique_ptr<UserAccount>& account = shard.accounts[username];
+            if (account) return;  // already restored
+            
+            PasswordHash password;
+            if (record.kind == JournalRecord::OPEN_ACCOUNT) {
+                password = PasswordHash::create(std::string(record.password));
+                plaintextPasswords = true;
+            } else if (!PasswordHash::fromBytes(record.password, password)) {
+                return;
+            }
+            
+            account = std::make_unique<UserAccount>(username, password, Money::fromMicros(record.amount));
+            if (accounts.size() <= record.account) accounts.resize(record.account + 1, nullptr);
+            accounts[record.account] = account.get();
+            return;
+        }
+        
+        if (record.account >= accounts.size() || !accounts[record.account]) return;
+        UserAccount& account = *accounts[record.account];
+        
+        Transaction::Type type = (Transaction::Type)record.type;
+        std::string description(record.description);
+        Money amount = Money::fromMicros(record.amount);
+        switch (record.kind) {
+            case JournalRecord::RESET:
+                account.reset(amount);
+                break;
+            case JournalRecord::TRANSACTION:
+                account.restoreTransaction(Transaction(type, amount < Money() ? -amount : amount, description,
+                                                       record.day, record.timestamp), amount);
+                break;
+            case JournalRecord::HISTORY:
+                account.restoreTransaction(Transaction(type, amount, description, record.day, record.timestamp),
+                                           Money());
+                break;
+            default:
+                break;
+        }
+    }
     
     // Member variables
-    std::unordered_map<std::string, std::unique_ptr<UserAccount>> accounts_;
+    std::unique_ptr<WriteAheadLog> journal_;   // null unless openJournal() succeeded
+    std::vector<UserAccount*> journalAccounts_; // by journal id
+    std::mutex journalMutex_;                  // guards journalAccounts_ and compaction
+    
+    std::array<Shard, kShardCount> shards_;
     std::string currentUser_;
-    mutable std::mutex mutex_;  // For thread safety
+    AccountHandle currentSession_;     // session of currentUser_
+    mutable std::mutex sessionMutex_;  // guards currentUser_ and currentSession_ only
+    
+    std::priority_queue<ScheduledEntry, std::vector<ScheduledEntry>, LaterEntry> schedule_;
+    uint64_t scheduleSequence_ = 0;
+    mutable std::mutex scheduleMutex_;  // guards schedule_ and scheduleSequence_
 };
 
 #endif // BANKINGSYSTEM_H
@@ -2,18 +2,42 @@
 // Implementation of the Facade pattern for the Banking Trading System
 
 #include "BankingTradingFacade.h"
+#include "SimulationCheckpoint.h"
+#include <unordered_set>
 
 // Constructor
-BankingTradingFacade::BankingTradingFacade() : currentDay_(1) {
+BankingTradingFacade::BankingTradingFacade()
+    : currentDay_(1), scheduler_(market_), priceHistoryEnabled_(false) {
 }
 
+BankingTradingFacade::~BankingTradingFacade() = default;
+
 // Helper methods to access singleton subsystems
 BankingSystem& BankingTradingFacade::getBankingSystem() const {
     return BankingSystem::getInstance();
 }
 
 TradingBot& BankingTradingFacade::getTradingBot() const {
-    return TradingBot::getInstance();
+    return getTradingBotFor(getBankingSystem().getCurrentUser());
+}
+
+TradingBot& BankingTradingFacade::getTradingBotFor(const std::string& account) const {
+    StockMarket& market = const_cast<StockMarket&>(market_);
+    
+    // No account, no bot to schedule: queries get an idle bot with empty results
+    if (account.empty()) {
+        if (!idleBot_) {
+            idleBot_ = std::make_unique<TradingBot>(market, getBankingSystem(), account);
+        }
+        return *idleBot_;
+    }
+    
+    auto it = bots_.find(account);
+    if (it == bots_.end()) {
+        it = bots_.emplace(account, std::make_unique<TradingBot>(market, getBankingSystem(), account)).first;
+        scheduler_.addBot(it->second.get());
+    }
+    return *it->second;
 }
 
 std::string BankingTradingFacade::transactionTypeToString(Transaction::Type type) const {
@@ -33,7 +57,7 @@ bool BankingTradingFacade::login(const std::string& username, const std::string&
 }
 
 bool BankingTradingFacade::registerUser(const std::string& username, const std::string& password, 
-                                double initialBalance) {
+                                Money initialBalance) {
     return getBankingSystem().registerUser(username, password, initialBalance);
 }
 
@@ -43,6 +67,7 @@ void BankingTradingFacade::logout() {
         getTradingBot().stopBot();
     }
     getBankingSystem().logout();
+    saveTradingState();
 }
 
 bool BankingTradingFacade::isLoggedIn() const {
@@ -53,60 +78,121 @@ std::string BankingTradingFacade::getCurrentUser() const {
     return getBankingSystem().getCurrentUser();
 }
 
+bool BankingTradingFacade::openJournal(const std::string& directory) {
+    if (!getBankingSystem().openJournal(directory)) {
+        return false;
+    }
+    
+    // The journal only holds cash; holdings, trades and the market day are
+    // saved beside it and come back on top of the recovered accounts
+    tradingState_ = std::make_unique<RollingCheckpoint>(directory + "/trading.ckpt");
+    SimulationCheckpoint checkpoint;
+    if (tradingState_->load(checkpoint)) {
+        restoreCheckpoint(checkpoint);
+    }
+    return true;
+}
+
 // --- Banking Operations ---
 // Handle deposits, withdrawals, transactions, and scheduled deposits
 
-bool BankingTradingFacade::deposit(double amount, const std::string& description, int day) {
+bool BankingTradingFacade::deposit(Money amount, const std::string& description, int day) {
     return getBankingSystem().deposit(amount, description, day);
 }
 
-bool BankingTradingFacade::withdraw(double amount, const std::string& description, int day) {
+bool BankingTradingFacade::withdraw(Money amount, const std::string& description, int day) {
     return getBankingSystem().withdraw(amount, description, day);
 }
 
-double BankingTradingFacade::getBalance() const {
+Money BankingTradingFacade::getBalance() const {
     return getBankingSystem().getBalance();
 }
 
-std::vector<BankingTradingFacade::SimpleTransaction> BankingTradingFacade::getTransactionHistory() const {
+BankingTradingFacade::SimpleTransaction BankingTradingFacade::toSimpleTransaction(const Transaction& trans) const {
+    SimpleTransaction st;
+    st.type = transactionTypeToString(trans.getType());
+    st.amount = trans.getAmount();
+    st.description = trans.getDescription();
+    st.day = trans.getDay();
+    st.timestamp = trans.getTimestampMicros();
+    return st;
+}
+
+std::vector<BankingTradingFacade::SimpleTransaction>
+BankingTradingFacade::toSimpleTransactions(const std::vector<Transaction>& transactions) const {
     std::vector<SimpleTransaction> result;
-    std::vector<Transaction> transactions = getBankingSystem().getTransactionHistory();
+    result.reserve(transactions.size());
     
     for (const auto& trans : transactions) {
-        SimpleTransaction st;
-        st.type = transactionTypeToString(trans.getType());
-        st.amount = trans.getAmount();
-        st.description = trans.getDescription();
-        st.day = trans.getDay();
-        st.timestamp = trans.getTimestamp();
-        result.push_back(st);
+        result.push_back(toSimpleTransaction(trans));
     }
     
     return result;
 }
 
-bool BankingTradingFacade::scheduleDeposit(int day, double amount, const std::string& description) {
+std::vector<BankingTradingFacade::SimpleTransaction> BankingTradingFacade::getTransactionHistory() const {
+    return toSimpleTransactions(getBankingSystem().getTransactionHistory());
+}
+
+size_t BankingTradingFacade::getTransactionCount() const {
+    return getBankingSystem().getTransactionCount();
+}
+
+std::vector<BankingTradingFacade::SimpleTransaction>
+BankingTradingFacade::getTransactionPage(size_t offset, size_t limit) const {
+    return toSimpleTransactions(getBankingSystem().getTransactions(offset, limit));
+}
+
+std::vector<BankingTradingFacade::SimpleTransaction> BankingTradingFacade::getRecentTransactions(size_t count) const {
+    return toSimpleTransactions(getBankingSystem().getRecentTransactions(count));
+}
+
+std::vector<BankingTradingFacade::SimpleTransaction>
+BankingTradingFacade::getTransactionsByDay(int fromDay, int toDay) const {
+    return toSimpleTransactions(getBankingSystem().getTransactionsByDay(fromDay, toDay));
+}
+
+void BankingTradingFacade::forEachTransaction(const std::function<void(const SimpleTransaction&)>& visit) const {
+    getBankingSystem().visitTransactions([&](const Transaction& trans) {
+        visit(toSimpleTransaction(trans));
+    });
+}
+
+bool BankingTradingFacade::scheduleDeposit(int day, Money amount, const std::string& description) {
     return getBankingSystem().scheduleDeposit(day, amount, description);
 }
 
-std::vector<BankingTradingFacade::SimpleScheduledDeposit> BankingTradingFacade::getScheduledDeposits() const {
-    std::vector<SimpleScheduledDeposit> result;
-    std::vector<ScheduledDeposit> scheduled = getBankingSystem().getScheduledDeposits();
+bool BankingTradingFacade::scheduleTransfer(int firstDay, Money amount, const std::string& description,
+                                            bool withdrawal, int interval, int endDay) {
+    ScheduledTransfer::Kind kind = withdrawal ? ScheduledTransfer::WITHDRAWAL : ScheduledTransfer::DEPOSIT;
+    return getBankingSystem().scheduleTransfer(
+        ScheduledTransfer(firstDay, amount, description, kind, interval, endDay));
+}
+
+std::vector<BankingTradingFacade::SimpleScheduledTransfer> BankingTradingFacade::getScheduledTransfers() const {
+    std::vector<SimpleScheduledTransfer> result;
+    std::vector<ScheduledTransfer> scheduled = getBankingSystem().getScheduledTransfers();
     
-    for (const auto& dep : scheduled) {
-        SimpleScheduledDeposit sd;
-        sd.scheduledDay = dep.getScheduledDay();
-        sd.amount = dep.getAmount();
-        sd.description = dep.getDescription();
-        sd.executed = dep.isExecuted();
-        result.push_back(sd);
+    for (const auto& rule : scheduled) {
+        SimpleScheduledTransfer st;
+        st.scheduledDay = rule.getScheduledDay();
+        st.nextDay = rule.getNextDay();
+        st.interval = rule.getInterval();
+        st.endDay = rule.getEndDay();
+        st.withdrawal = (rule.getKind() == ScheduledTransfer::WITHDRAWAL);
+        st.amount = rule.getAmount();
+        st.description = rule.getDescription();
+        st.executedCount = rule.getExecutedCount();
+        st.missedCount = rule.getMissedCount();
+        st.executed = rule.isExecuted();
+        result.push_back(st);
     }
     
     return result;
 }
 
-int BankingTradingFacade::executeScheduledDeposits(int currentDay) {
-    return getBankingSystem().executeScheduledDeposits(currentDay);
+int BankingTradingFacade::executeScheduledTransfers(int currentDay) {
+    return getBankingSystem().executeScheduledTransfers(currentDay);
 }
 
 // --- Trading Bot Operations ---
@@ -118,11 +204,13 @@ bool BankingTradingFacade::startBot() {
     }
     
     getTradingBot().startBot();
+    saveTradingState();
     return true;
 }
 
 bool BankingTradingFacade::stopBot() {
     getTradingBot().stopBot();
+    saveTradingState();
     return true;
 }
 
@@ -134,16 +222,78 @@ std::string BankingTradingFacade::getBotStatus() const {
     return isBotRunning() ? "ACTIVE" : "INACTIVE";
 }
 
+bool BankingTradingFacade::setStrategy(const std::string& name, bool autoSwitch) {
+    getTradingBot().setAutoSwitch(autoSwitch);
+    bool changed = getTradingBot().setStrategy(name);
+    saveTradingState();
+    return changed;
+}
+
+bool BankingTradingFacade::loadUniverse(const std::vector<StockListing>& listings, std::string& error) {
+    if (!listsEveryHolding(listings, error)) {
+        return false;
+    }
+    market_.loadUniverse(listings);
+    return true;
+}
+
+bool BankingTradingFacade::loadUniverseFile(const std::string& path, std::string& error) {
+    std::vector<StockListing> listings;
+    if (!StockMarket::readUniverseFile(path, listings, error) || !listsEveryHolding(listings, error)) {
+        return false;
+    }
+    market_.reloadUniverse(listings);
+    return true;
+}
+
+// An unlisted stock has no price, so a position in it would be sold off at $0
+bool BankingTradingFacade::listsEveryHolding(const std::vector<StockListing>& listings, std::string& error) const {
+    std::unordered_set<std::string> listed;
+    listed.reserve(listings.size());
+    for (const auto& listing : listings) {
+        listed.insert(listing.ticker_symbol);
+    }
+    
+    for (const auto& entry : bots_) {
+        for (const auto& holding : entry.second->getPortfolio()) {
+            if (!listed.count(holding.ticker_symbol)) {
+                error = "Account " + entry.first + " holds " + holding.ticker_symbol +
+                        ", which the new universe does not list";
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void BankingTradingFacade::setSeed(uint64_t seed) {
+    market_.setSeed(seed);
+}
+
+void BankingTradingFacade::setPriceHistoryEnabled(bool enabled) {
+    priceHistoryEnabled_ = enabled;
+    recordPriceHistory();  // start from today's prices
+}
+
+void BankingTradingFacade::recordPriceHistory() {
+    if (priceHistoryEnabled_) {
+        priceHistory_.recordPrices(market_);
+    }
+}
+
+size_t BankingTradingFacade::getPriceHistory(const std::string& symbol, int fromDay, int toDay,
+                                             std::vector<int>& days, std::vector<double>& closes) const {
+    return priceHistory_.getPrices(symbol, fromDay, toDay, days, closes);
+}
+
 // --- Stock Market Data ---
 // Get current market prices and stock information
 
 std::vector<BankingTradingFacade::SimpleStockInfo> BankingTradingFacade::getMarketData() {
     std::vector<SimpleStockInfo> result;
     
-    // Get stock data from TradingBot
-    std::vector<StockFields> stocks = getTradingBot().getAllStocks();
-    
-    for (const auto& stock : stocks) {
+    // Get stock data from the shared market
+    for (const auto& stock : market_.getStocks()) {
         SimpleStockInfo info;
         info.symbol = stock.ticker_symbol;
         info.name = stock.name;
@@ -198,64 +348,79 @@ std::vector<BankingTradingFacade::SimplePortfolioItem> BankingTradingFacade::get
 }
 
 // --- Performance Tracking ---
-// Calculate profit, success rate, and trading statistics
+// Profit, holdings and trading statistics. The bot keeps its statistics up to
+// date as it trades, so this only reads them (and prices the few holdings).
 
 BankingTradingFacade::PerformanceSummary BankingTradingFacade::getPerformance() {
     PerformanceSummary summary;
+    TradingBot& bot = getTradingBot();
     
     summary.daysElapsed = currentDay_;
-    
-    // Get trade history from TradingBot
-    std::vector<TradeRecords> trades = getTradingBot().getHistory();
-    summary.tradesExecuted = trades.size();
+    summary.analytics = bot.getPerformanceStats();
+    summary.tradesExecuted = bot.getTradeCount();
+    summary.successRate = summary.analytics.winRate;
     
     // Get total profit (realized + unrealized) from TradingBot
-    summary.totalProfit = getTradingBot().getProfit();
+    summary.totalProfit = bot.getProfit();
+    summary.totalShares = bot.getTotalShares();
+    summary.totalValue = bot.getHoldingsValue();
     
-    // Calculate totals from portfolio
-    summary.totalShares = 0;
-    summary.totalValue = 0.0;
+    return summary;
+}
+
+std::vector<double> BankingTradingFacade::getEquityCurve() {
+    const CompressedSeries& curve = getTradingBot().getEquityCurve();
+    std::vector<double> result;
+    result.reserve(curve.size());
+    curve.forEachInRange(curve.getFirstDay(), curve.getLastDay(), [&](int, double equity) {
+        result.push_back(equity);
+    });
+    return result;
+}
+
+size_t BankingTradingFacade::getEquityHistory(int fromDay, int toDay,
+                                              std::vector<int>& days, std::vector<double>& equity) {
+    return getTradingBot().getEquityCurve().getRange(fromDay, toDay, days, equity);
+}
+
+BankingTradingFacade::SimpleTradeRecord BankingTradingFacade::toSimpleTradeRecord(const TradeRecords& trade) const {
+    SimpleTradeRecord str;
+    str.type = trade.type;
+    str.symbol = trade.ticker_symbol;
+    str.shares = trade.shares;
+    str.price = trade.cost;
+    str.total = trade.total;
+    str.day = trade.day;
+    str.reason = trade.reason;
+    return str;
+}
+
+std::vector<BankingTradingFacade::SimpleTradeRecord> BankingTradingFacade::getTradeHistory() {
+    std::vector<SimpleTradeRecord> result;
     
-    std::vector<Portfolio> portfolio = getTradingBot().getPortfolio();
-    for (const auto& item : portfolio) {
-        summary.totalShares += item.shares;
-        double currentPrice = getTradingBot().getPrice(item.ticker_symbol);
-        summary.totalValue += item.getValue(currentPrice);
-    }
+    std::vector<TradeRecords> trades = getTradingBot().getHistory();
+    result.reserve(trades.size());
     
-    // Calculate success rate
-    int profitable = 0;
     for (const auto& trade : trades) {
-        if (trade.type == "SELL" && trade.total > 0) {
-            profitable++;
-        }
-    }
-    
-    if (trades.size() > 0) {
-        summary.successRate = (double)profitable / trades.size() * 100.0;
-    } else {
-        summary.successRate = 0.0;
+        result.push_back(toSimpleTradeRecord(trade));
     }
     
-    return summary;
+    return result;
 }
 
-std::vector<BankingTradingFacade::SimpleTradeRecord> BankingTradingFacade::getTradeHistory() {
+size_t BankingTradingFacade::getTradeCount() {
+    return getTradingBot().getTradeCount();
+}
+
+// One page of the trade history, so views of long histories copy only what they show
+std::vector<BankingTradingFacade::SimpleTradeRecord> BankingTradingFacade::getTradePage(size_t offset, size_t limit) {
     std::vector<SimpleTradeRecord> result;
     
-    std::vector<TradeRecords> trades = getTradingBot().getHistory();
+    std::vector<TradeRecords> trades = getTradingBot().getHistoryPage(offset, limit);
+    result.reserve(trades.size());
     
     for (const auto& trade : trades) {
-        SimpleTradeRecord str;
-        str.type = trade.type;
-        str.symbol = trade.ticker_symbol;
-        str.shares = trade.shares;
-        str.price = trade.cost;
-        str.total = trade.total;
-        str.day = trade.day;
-        str.reason = trade.reason;
-        
-        result.push_back(str);
+        result.push_back(toSimpleTradeRecord(trade));
     }
     
     return result;
@@ -267,40 +432,135 @@ std::vector<BankingTradingFacade::SimpleTradeRecord> BankingTradingFacade::getTr
 int BankingTradingFacade::advanceDay() {
     currentDay_++;
     
-    // Advance the trading bot's day
-    getTradingBot().advanceDay();
+    // Advance the shared market
+    market_.advanceDay();
+    recordPriceHistory();
     
-    // Execute scheduled deposits
-    executeScheduledDeposits(currentDay_);
+    // Execute scheduled transfers due today, for every account
+    executeScheduledTransfers(currentDay_);
     
-    // If bot is running, execute trading cycle
-    if (isBotRunning()) {
-        getTradingBot().executeTradingCycle();
-    }
+    // Every account's running bot trades on the new prices
+    scheduler_.runTradingCycles();
+    
+    // Nothing is trading between days, so the journal can be compacted safely
+    getBankingSystem().compactJournalIfNeeded();
+    saveTradingState();
     
     return currentDay_;
 }
 
+// Run several days in one call. The bank's deposit scheduler only does work on
+// days where a deposit is due, and trade history is left in the bot until
+// someone asks for it. Each day is saved like advanceDay() does, so a crash
+// loses at most the day in progress.
+BankingTradingFacade::FastForwardSummary BankingTradingFacade::advanceDays(int days) {
+    FastForwardSummary summary;
+    BankingSystem& bank = getBankingSystem();
+    TradingBot& bot = getTradingBot();
+    
+    summary.startDay = currentDay_;
+    summary.depositsExecuted = 0;
+    summary.startingBalance = bank.getBalance();
+    int startTrades = bot.getTradeCount();
+    
+    for (int i = 0; i < days; i++) {
+        currentDay_++;
+        market_.advanceDay();
+        recordPriceHistory();
+        
+        if (bank.getNextScheduledDay() <= currentDay_) {
+            summary.depositsExecuted += bank.executeScheduledTransfers(currentDay_);
+        }
+        
+        scheduler_.runTradingCycles();
+        bank.compactJournalIfNeeded();
+        saveTradingState();
+    }
+    
+    summary.endDay = currentDay_;
+    summary.tradesExecuted = bot.getTradeCount() - startTrades;
+    summary.endingBalance = bank.getBalance();
+    summary.totalProfit = bot.getProfit();
+    
+    return summary;
+}
+
 int BankingTradingFacade::getCurrentDay() const {
     return currentDay_;
 }
 
-void BankingTradingFacade::resetSimulation() {
-    // Stop bot
-    if (isBotRunning()) {
-        getTradingBot().stopBot();
-    }
+void BankingTradingFacade::resetSimulation(Money initialBalance) {
+    // The shared market restarts, so every account's bot and balance start over
+    market_.reset();
+    priceHistory_.clear();
+    recordPriceHistory();
     
-    // Reset trading bot
-    getTradingBot().reset();
+    for (auto& entry : bots_) {
+        entry.second->reset();  // also stops the bot
+        getBankingSystem().resetAccount(entry.first, initialBalance);
+    }
     
     // Reset current account
     if (isLoggedIn()) {
-        getBankingSystem().resetCurrentAccount(10000.0);
+        getBankingSystem().resetCurrentAccount(initialBalance);
     }
     
     // Reset day
     currentDay_ = 1;
+    if (tradingState_) tradingState_->restartHistory();
+    saveTradingState();
+}
+
+// Checkpoints cover the shared market, every account's bot and the whole bank
+bool BankingTradingFacade::saveCheckpoint(const std::string& path) const {
+    std::vector<const TradingBot*> bots;
+    for (const auto& entry : bots_) {
+        bots.push_back(entry.second.get());
+    }
+    return SimulationCheckpoint::capture(market_, bots, getBankingSystem()).save(path);
+}
+
+bool BankingTradingFacade::loadCheckpoint(const std::string& path) {
+    SimulationCheckpoint checkpoint;
+    if (!checkpoint.load(path)) return false;
+    
+    bool restored = restoreCheckpoint(checkpoint);
+    if (tradingState_) tradingState_->restartHistory();
+    saveTradingState();
+    return restored;
+}
+
+// Put back the market and bots of `checkpoint`, and its accounts if it has any
+bool BankingTradingFacade::restoreCheckpoint(const SimulationCheckpoint& checkpoint) {
+    // every account that had a bot gets one again
+    for (const auto& bot : checkpoint.bots) {
+        getTradingBotFor(bot.account);
+    }
+    
+    std::vector<TradingBot*> bots;
+    for (auto& entry : bots_) {
+        bots.push_back(entry.second.get());
+    }
+    bool restored = checkpoint.restore(market_, bots, getBankingSystem());
+    currentDay_ = market_.getCurrentDay();
+    
+    // history recorded after the checkpoint was taken no longer happened
+    priceHistory_.clear();
+    recordPriceHistory();
+    return restored;
+}
+
+// Cash is already in the journal, so only the market and bots are written.
+// The journal is synced first, so saved holdings never get ahead of cash.
+void BankingTradingFacade::saveTradingState() const {
+    if (!tradingState_) return;
+    
+    getBankingSystem().syncJournal();
+    std::vector<const TradingBot*> bots;
+    for (const auto& entry : bots_) {
+        bots.push_back(entry.second.get());
+    }
+    tradingState_->save(market_, bots);
 }
 
 std::string BankingTradingFacade::getMarketCondition() {
@@ -311,14 +571,13 @@ bool BankingTradingFacade::tryEndWithProfit(int maxWaitDays, int& currentWaitDay
     // Stop the bot first
     stopBot();
     
-    // Try to end with profit
+    // Try to end with profit. Waiting is a normal market day for everyone
+    // else: transfers run and the other accounts' bots trade.
     while (!getTradingBot().tryEndWithProfit(maxWaitDays, currentWaitDay)) {
         currentWaitDay++;
-        currentDay++;
-        currentDay_ = currentDay;
-        getTradingBot().advanceDay();
-        getTradingBot().executeTradingCycle();
+        currentDay = advanceDay();
     }
+    saveTradingState();
     
     return true;
 }
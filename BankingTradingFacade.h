@@ -7,9 +7,17 @@
 
 #include "BankingSystem.h"
 #include "TradingBot.h"
+#include "BotScheduler.h"
+#include "TimeSeriesStore.h"
+#include <functional>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+struct SimulationCheckpoint;
+class RollingCheckpoint;
+
 // Banking Trading Facade - Singleton + Facade Pattern
 // Simplifies interaction between GUI and backend subsystems
 class BankingTradingFacade {
@@ -27,42 +35,69 @@ public:
     // Authentication methods
     bool login(const std::string& username, const std::string& password);
     bool registerUser(const std::string& username, const std::string& password, 
-                     double initialBalance = 10000.0);
+                     Money initialBalance = Money::units(10000));
     void logout();
     bool isLoggedIn() const;
     std::string getCurrentUser() const;
     
+    // Persistence: restore accounts saved in `directory` and keep saving every
+    // change there, along with the market and every account's bot (saved after
+    // each trading day, reset and bot setting change). Call at startup, before
+    // anyone registers or logs in.
+    bool openJournal(const std::string& directory);
+    
     // Banking operations
-    bool deposit(double amount, const std::string& description, int day);
-    bool withdraw(double amount, const std::string& description, int day);
-    double getBalance() const;
+    bool deposit(Money amount, const std::string& description, int day);
+    bool withdraw(Money amount, const std::string& description, int day);
+    Money getBalance() const;
     
     // Transaction history
     struct SimpleTransaction {
         std::string type;
-        double amount;
+        Money amount;
         std::string description;
         int day;
-        std::string timestamp;
+        int64_t timestamp;  // microseconds since the epoch, see Transaction::formatTimestamp
     };
     std::vector<SimpleTransaction> getTransactionHistory() const;
     
-    // Scheduled deposits
-    struct SimpleScheduledDeposit {
-        int scheduledDay;
-        double amount;
+    // Paged and streaming access, so large histories aren't copied whole
+    size_t getTransactionCount() const;
+    std::vector<SimpleTransaction> getTransactionPage(size_t offset, size_t limit) const;
+    std::vector<SimpleTransaction> getRecentTransactions(size_t count) const;
+    std::vector<SimpleTransaction> getTransactionsByDay(int fromDay, int toDay) const;
+    void forEachTransaction(const std::function<void(const SimpleTransaction&)>& visit) const;
+    
+    // Scheduled transfers (one-off or recurring deposits and withdrawals)
+    struct SimpleScheduledTransfer {
+        int scheduledDay;     // first occurrence
+        int nextDay;          // next occurrence, INT_MAX once finished
+        int interval;         // days between occurrences, 0 = one-off
+        int endDay;
+        bool withdrawal;
+        Money amount;
         std::string description;
-        bool executed;
+        int executedCount;
+        int missedCount;      // withdrawals skipped for lack of funds
+        bool executed;        // no occurrences left
     };
-    bool scheduleDeposit(int day, double amount, const std::string& description);
-    std::vector<SimpleScheduledDeposit> getScheduledDeposits() const;
-    int executeScheduledDeposits(int currentDay);
+    bool scheduleDeposit(int day, Money amount, const std::string& description);
+    bool scheduleTransfer(int firstDay, Money amount, const std::string& description,
+                          bool withdrawal, int interval, int endDay);
+    std::vector<SimpleScheduledTransfer> getScheduledTransfers() const;
+    int executeScheduledTransfers(int currentDay);  // every account's transfers due by currentDay
     
     // Trading bot operations
     bool startBot();
     bool stopBot();
     bool isBotRunning() const;
     std::string getBotStatus() const;
+    bool setStrategy(const std::string& name, bool autoSwitch);
+    // Replace the tradable stocks (loadUniverseFile keeps the prices of stocks
+    // still listed). Refused, with a reason in `error`, if a held stock is missing.
+    bool loadUniverse(const std::vector<StockListing>& listings, std::string& error);
+    bool loadUniverseFile(const std::string& path, std::string& error);
+    void setSeed(uint64_t seed);
     
     // Market data access
     struct SimpleStockInfo {
@@ -76,13 +111,19 @@ public:
     std::vector<SimpleStockInfo> getMarketData();
     void refreshMarketData();
     
+    // Daily closing prices, kept compressed (see TimeSeriesStore). Off by
+    // default; days advanced while it is off are not recorded.
+    void setPriceHistoryEnabled(bool enabled);
+    size_t getPriceHistory(const std::string& symbol, int fromDay, int toDay,
+                           std::vector<int>& days, std::vector<double>& closes) const;
+    
     // Portfolio information
     struct SimplePortfolioItem {
         std::string symbol;
         int shares;
-        double averagePrice;
-        double currentValue;
-        double profit;
+        Money averagePrice;
+        Money currentValue;
+        Money profit;
         double profitPercent;
     };
     std::vector<SimplePortfolioItem> getPortfolio();
@@ -90,31 +131,53 @@ public:
     // Performance summary
     
     struct PerformanceSummary {
-        double totalProfit;
-        double totalValue;
+        Money totalProfit;
+        Money totalValue;
         int totalShares;
         int daysElapsed;
         int tradesExecuted;
-        double successRate;
+        double successRate;          // profitable sells per sell, as a percentage
+        PerformanceStats analytics;  // equity curve statistics (drawdown, Sharpe, Sortino, ...)
     };
     PerformanceSummary getPerformance();
+    std::vector<double> getEquityCurve();  // one sample per day the bot traded
+    size_t getEquityHistory(int fromDay, int toDay, std::vector<int>& days, std::vector<double>& equity);
     
     // Trade history
     struct SimpleTradeRecord {
         std::string type;      // "BUY" or "SELL"
         std::string symbol;
         int shares;
-        double price;
-        double total;
+        Money price;
+        Money total;
         int day;
         std::string reason;
     };
     std::vector<SimpleTradeRecord> getTradeHistory();
+    size_t getTradeCount();
+    std::vector<SimpleTradeRecord> getTradePage(size_t offset, size_t limit);  // offset 0 = oldest
     
     // Day management and simulation control
     int advanceDay();
+    
+    // Fast-forward summary (returned instead of per-day snapshots)
+    struct FastForwardSummary {
+        int startDay;
+        int endDay;
+        int depositsExecuted;
+        int tradesExecuted;
+        Money startingBalance;
+        Money endingBalance;
+        Money totalProfit;
+    };
+    FastForwardSummary advanceDays(int days);
     int getCurrentDay() const;
-    void resetSimulation();
+    void resetSimulation(Money initialBalance = Money::units(10000));
+    
+    // Save the whole simulation (market, bots, accounts) to a binary file, or
+    // go back to one. Loading replaces the state of every saved account.
+    bool saveCheckpoint(const std::string& path) const;
+    bool loadCheckpoint(const std::string& path);
     
     // Market and simulation methods
     std::string getMarketCondition();
@@ -123,17 +186,41 @@ public:
 private:
     // Private constructor for Singleton
     BankingTradingFacade();
-    ~BankingTradingFacade() = default;
+    ~BankingTradingFacade();  // out of line: RollingCheckpoint is incomplete here
     
     // Current simulation day
     int currentDay_;
     
+    // Market shared by every account's bot, one bot per account (created on first use)
+    StockMarket market_;
+    mutable std::unordered_map<std::string, std::unique_ptr<TradingBot>> bots_;
+    mutable BotScheduler scheduler_;
+    
+    // Stands in while nobody is logged in: never scheduled or saved, has no account
+    mutable std::unique_ptr<TradingBot> idleBot_;
+    
+    // Closing price history of market_, recorded once per advanced day when enabled
+    TimeSeriesStore priceHistory_;
+    bool priceHistoryEnabled_;
+    void recordPriceHistory();
+    
+    // Market and bots saved beside the account journal (null while there is none)
+    std::unique_ptr<RollingCheckpoint> tradingState_;
+    void saveTradingState() const;
+    bool listsEveryHolding(const std::vector<StockListing>& listings, std::string& error) const;
+    bool restoreCheckpoint(const SimulationCheckpoint& checkpoint);
+    
     // Helper methods to access subsystems
     BankingSystem& getBankingSystem() const;
-    TradingBot& getTradingBot() const;
+    TradingBot& getTradingBot() const;  // bot of the logged-in account (idle bot if none)
+    TradingBot& getTradingBotFor(const std::string& account) const;  // created on first use
     
     // Helper to convert Transaction enum to string
     std::string transactionTypeToString(Transaction::Type type) const;
+    
+    SimpleTransaction toSimpleTransaction(const Transaction& transaction) const;
+    SimpleTradeRecord toSimpleTradeRecord(const TradeRecords& trade) const;
+    std::vector<SimpleTransaction> toSimpleTransactions(const std::vector<Transaction>& transactions) const;
 };
 
 #endif // BANKINGRADINGFACADE_H
\ No newline at end of file
@@ -4,17 +4,16 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 CONFIG += c++17
 
+include(SimulationEngine.pri)
+
 SOURCES += \
     main.cpp \
     MainWindow.cpp \
-    BankingTradingFacade.cpp
+    TableModels.cpp
 
 HEADERS += \
-    BankingSystem.h \
     MainWindow.h \
-    StockAbstractFactory.h \
-    TradingBot.h \
-    BankingTradingFacade.h
+    TableModels.h
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
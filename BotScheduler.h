@@ -0,0 +1,83 @@
+// BotScheduler.h
+// Runs many per-account trading bots against one shared StockMarket.
+// Each day the market is advanced once, then the bots' trading cycles run in
+// parallel, one shard of bots per task. Bots only read the market during their
+// cycle and only touch their own portfolio and account, so shards never share state.
+
+#ifndef BOTSCHEDULER_H
+#define BOTSCHEDULER_H
+
+#include "TradingBot.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class BotScheduler {
+public:
+    // shards == 0 means one shard per hardware thread
+    explicit BotScheduler(StockMarket& market, unsigned shards = 0)
+        : market_(market), botCount_(0) {
+        if (shards == 0) shards = std::max(1u, std::thread::hardware_concurrency());
+        shards_.resize(shards);
+    }
+
+    BotScheduler(const BotScheduler&) = delete;
+    BotScheduler& operator=(const BotScheduler&) = delete;
+
+    // Bots must trade on this scheduler's market and outlive their registration
+    void addBot(TradingBot* bot) {
+        shards_[botCount_ % shards_.size()].push_back(bot);
+        botCount_++;
+    }
+
+    void removeBot(TradingBot* bot) {
+        for (auto& shard : shards_) {
+            auto it = std::find(shard.begin(), shard.end(), bot);
+            if (it != shard.end()) {
+                shard.erase(it);
+                botCount_--;
+                return;
+            }
+        }
+    }
+
+    size_t getBotCount() const { return botCount_; }
+
+    // Advance the shared market, then let every running bot trade
+    void advanceDay() {
+        market_.advanceDay();
+        runTradingCycles();
+    }
+
+    // One trading cycle for every running bot, shards in parallel
+    void runTradingCycles() {
+        if (botCount_ <= 1 || shards_.size() == 1) {
+            for (auto& shard : shards_) {
+                runShard(shard);
+            }
+            return;
+        }
+
+        if (!pool_) {
+            pool_ = std::make_unique<WorkStealingPool>((unsigned)shards_.size());
+        }
+        pool_->parallelFor(shards_.size(), [this](size_t i) {
+            runShard(shards_[i]);
+        });
+    }
+
+private:
+    static void runShard(const std::vector<TradingBot*>& shard) {
+        for (TradingBot* bot : shard) {
+            bot->executeTradingCycle();  // stopped bots only take their equity sample
+        }
+    }
+
+    StockMarket& market_;
+    std::vector<std::vector<TradingBot*>> shards_;
+    size_t botCount_;
+    std::unique_ptr<WorkStealingPool> pool_;  // created on first parallel day
+};
+
+#endif // BOTSCHEDULER_H
@@ -0,0 +1,12 @@
+# Headless build: simulation engine library, command-line runner and benchmarks.
+# Does not need Qt widgets, so it can be built on servers without a display.
+
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    engine \
+    cli \
+    bench
+
+cli.depends = engine
+bench.depends = engine
@@ -4,7 +4,7 @@
 #include <QHeaderView>
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), currentDay(1) {
+    : QMainWindow(parent), currentDay(BankingTradingFacade::getInstance().getCurrentDay()) {
     setupUI();
     updateUIState();
 }
@@ -67,7 +67,7 @@ void MainWindow::setupUI() {
         "   color: #0078d4;"
         "   font-size: 14px;"
         "}"
-        "QTableWidget {"
+        "QTableView {"
         "   border: 1px solid #555555;"
         "   border-radius: 4px;"
         "   background-color: #3c3c3c;"
@@ -75,7 +75,7 @@ void MainWindow::setupUI() {
         "   selection-background-color: #0078d4;"
         "   color: #ffffff;"
         "}"
-        "QTableWidget::item {"
+        "QTableView::item {"
         "   padding: 4px;"
         "}"
         "QHeaderView::section {"
@@ -373,7 +373,7 @@ void MainWindow::setupBankingPage() {
     withdrawLayout->addWidget(withdrawButton, 2, 0, 1, 2);
     withdrawBox->setLayout(withdrawLayout);
 
-    // Scheduled Deposits
+    // Scheduled Deposits (one-off or repeating, deposit or withdrawal)
     QGroupBox *scheduledBox = new QGroupBox("Schedule Future Deposit");
     QGridLayout *scheduledLayout = new QGridLayout();
 
@@ -395,6 +395,23 @@ void MainWindow::setupBankingPage() {
     scheduledDepositDay->setValue(5);
     scheduledLayout->addWidget(scheduledDepositDay, 2, 1);
 
+    scheduledLayout->addWidget(new QLabel("Repeat Every:"), 3, 0);
+    scheduledRepeatDays = new QSpinBox();
+    scheduledRepeatDays->setRange(0, 365);
+    scheduledRepeatDays->setValue(0);
+    scheduledRepeatDays->setSuffix(" days");
+    scheduledRepeatDays->setSpecialValueText("Once");
+    scheduledLayout->addWidget(scheduledRepeatDays, 3, 1);
+
+    scheduledLayout->addWidget(new QLabel("Until Day:"), 4, 0);
+    scheduledUntilDay = new QSpinBox();
+    scheduledUntilDay->setRange(2, 3650);
+    scheduledUntilDay->setValue(365);
+    scheduledLayout->addWidget(scheduledUntilDay, 4, 1);
+
+    scheduledWithdrawal = new QCheckBox("Withdrawal");
+    scheduledLayout->addWidget(scheduledWithdrawal, 5, 1);
+
     QHBoxLayout *scheduledButtonLayout = new QHBoxLayout();
     scheduleDepositButton = new QPushButton("Schedule Deposit");
     scheduleDepositButton->setMinimumHeight(35);
@@ -424,7 +441,7 @@ void MainWindow::setupBankingPage() {
 
     scheduledButtonLayout->addWidget(scheduleDepositButton);
     scheduledButtonLayout->addWidget(viewScheduledButton);
-    scheduledLayout->addLayout(scheduledButtonLayout, 3, 0, 1, 2);
+    scheduledLayout->addLayout(scheduledButtonLayout, 6, 0, 1, 2);
     scheduledBox->setLayout(scheduledLayout);
 
     // Display for the transaction History
@@ -444,12 +461,12 @@ void MainWindow::setupBankingPage() {
     );
     connect(viewTransactionsButton, &QPushButton::clicked, this, &MainWindow::onViewTransactionsClicked);
 
-    transactionDisplay = new QTextEdit();
-    transactionDisplay->setReadOnly(true);
-    transactionDisplay->setMaximumHeight(200);
+    transactionModel = new TransactionHistoryModel(this);
+    transactionTable = createTableView(transactionModel);
+    transactionTable->setMaximumHeight(200);
 
     historyLayout->addWidget(viewTransactionsButton);
-    historyLayout->addWidget(transactionDisplay);
+    historyLayout->addWidget(transactionTable);
     historyBox->setLayout(historyLayout);
 
     QHBoxLayout *operationsLayout = new QHBoxLayout();
@@ -512,11 +529,8 @@ void MainWindow::setupTradingPage() {
     QGroupBox *marketBox = new QGroupBox("📈 Stock Market");
     QVBoxLayout *marketLayout = new QVBoxLayout();
 
-    stockMarketTable = new QTableWidget();
-    stockMarketTable->setColumnCount(5);
-    stockMarketTable->setHorizontalHeaderLabels({"Symbol", "Company", "Price", "Change %", "Trend"});
-    stockMarketTable->horizontalHeader()->setStretchLastSection(true);
-    stockMarketTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    marketModel = new MarketTableModel(this);
+    stockMarketTable = createTableView(marketModel);
     stockMarketTable->setMinimumHeight(200);
     marketLayout->addWidget(stockMarketTable);
     marketBox->setLayout(marketLayout);
@@ -631,15 +645,12 @@ void MainWindow::setupTradingPage() {
     QGroupBox *portfolioBox = new QGroupBox("💼 Portfolio");
     QVBoxLayout *portfolioLayout = new QVBoxLayout();
 
-    portfolioTable = new QTableWidget();
-    portfolioTable->setColumnCount(5);
-    portfolioTable->setHorizontalHeaderLabels({"Symbol", "Shares", "Avg Price", "Current Value", "Profit"});
-    portfolioTable->horizontalHeader()->setStretchLastSection(true);
-    portfolioTable->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    portfolioModel = new PortfolioTableModel(this);
+    portfolioTable = createTableView(portfolioModel);
     portfolioTable->setMinimumHeight(150);
     portfolioTable->setAlternatingRowColors(true);
     portfolioTable->setStyleSheet(
-        "QTableWidget {"
+        "QTableView {"
         "   alternate-background-color: #404040;"
         "}"
     );
@@ -704,18 +715,18 @@ void MainWindow::setupTradingPage() {
     QGroupBox *tradeHistoryBox = new QGroupBox("📜 Trade History");
     QVBoxLayout *tradeHistoryLayout = new QVBoxLayout();
 
-    tradeHistoryDisplay = new QTextEdit();
-    tradeHistoryDisplay->setReadOnly(true);
-    tradeHistoryDisplay->setMaximumHeight(150);
-    tradeHistoryDisplay->setStyleSheet(
-        "QTextEdit {"
+    tradeHistoryModel = new TradeHistoryModel(this);
+    tradeHistoryTable = createTableView(tradeHistoryModel);
+    tradeHistoryTable->setMaximumHeight(150);
+    tradeHistoryTable->setStyleSheet(
+        "QTableView {"
         "   font-family: 'Courier New', monospace;"
         "   font-size: 12px;"
         "   background-color: #3c3c3c;"
         "   color: #ffffff;"
         "}"
     );
-    tradeHistoryLayout->addWidget(tradeHistoryDisplay);
+    tradeHistoryLayout->addWidget(tradeHistoryTable);
     tradeHistoryBox->setLayout(tradeHistoryLayout);
 
     layout->addWidget(marketBox);
@@ -768,7 +779,7 @@ void MainWindow::onRegisterClicked() {
 
     BankingTradingFacade& facade = BankingTradingFacade::getInstance();
 
-    if (facade.registerUser(username.toStdString(), password.toStdString(), 10000.0)) {
+    if (facade.registerUser(username.toStdString(), password.toStdString(), Money::units(10000))) {
         statusLabel->setText("Registration successful! Please login.");
         statusLabel->setStyleSheet("color: green;");
         passwordInput->clear();
@@ -784,7 +795,7 @@ void MainWindow::onLogoutClicked() {
     usernameInput->clear();
     passwordInput->clear();
     statusLabel->clear();
-    transactionDisplay->clear();
+    transactionModel->reload();
 
     updateUIState();
 }
@@ -798,7 +809,7 @@ void MainWindow::onDepositClicked() {
     double amount = depositAmount->value();
     QString description = depositDescription->text();
 
-    if (facade.deposit(amount, description.toStdString(), currentDay)) {
+    if (facade.deposit(Money::fromDouble(amount), description.toStdString(), currentDay)) {
         QMessageBox::information(this, "Success",
                                  QString("Deposited $%1 on day %2!").arg(amount, 0, 'f', 2).arg(currentDay));
         refreshBalance();
@@ -814,7 +825,7 @@ void MainWindow::onWithdrawClicked() {
     double amount = withdrawAmount->value();
     QString description = withdrawDescription->text();
 
-    if (facade.withdraw(amount, description.toStdString(), currentDay)) {
+    if (facade.withdraw(Money::fromDouble(amount), description.toStdString(), currentDay)) {
         QMessageBox::information(this, "Success",
                                  QString("Withdrew $%1 on day %2!").arg(amount, 0, 'f', 2).arg(currentDay));
         refreshBalance();
@@ -834,6 +845,9 @@ void MainWindow::onScheduleDepositClicked() {
     double amount = scheduledDepositAmount->value();
     QString description = scheduledDepositDescription->text();
     int day = scheduledDepositDay->value();
+    int interval = scheduledRepeatDays->value();
+    int untilDay = interval > 0 ? scheduledUntilDay->value() : day;
+    bool withdrawal = scheduledWithdrawal->isChecked();
 
     if (day <= currentDay) {
         QMessageBox::warning(this, "Error",
@@ -841,9 +855,19 @@ void MainWindow::onScheduleDepositClicked() {
         return;
     }
 
-    if (facade.scheduleDeposit(day, amount, description.toStdString())) {
+    if (untilDay < day) {
+        QMessageBox::warning(this, "Error", "The last day can't be before the first one!");
+        return;
+    }
+
+    if (facade.scheduleTransfer(day, Money::fromDouble(amount), description.toStdString(),
+                                withdrawal, interval, untilDay)) {
+        QString kind = withdrawal ? "withdrawal" : "deposit";
+        QString when = interval > 0
+            ? QString("every %1 days from day %2 to day %3").arg(interval).arg(day).arg(untilDay)
+            : QString("for day %1").arg(day);
         QMessageBox::information(this, "Success",
-                                 QString("Scheduled $%1 deposit for day %2").arg(amount, 0, 'f', 2).arg(day));
+                                 QString("Scheduled $%1 %2 %3").arg(amount, 0, 'f', 2).arg(kind).arg(when));
     } else {
         QMessageBox::warning(this, "Error", "Failed to schedule deposit!");
     }
@@ -851,7 +875,7 @@ void MainWindow::onScheduleDepositClicked() {
 
 void MainWindow::onViewScheduledDepositsClicked() {
     BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    std::vector<BankingTradingFacade::SimpleScheduledDeposit> scheduled = facade.getScheduledDeposits();
+    std::vector<BankingTradingFacade::SimpleScheduledTransfer> scheduled = facade.getScheduledTransfers();
 
     QString message;
     if (scheduled.empty()) {
@@ -859,10 +883,15 @@ void MainWindow::onViewScheduledDepositsClicked() {
     } else {
         message = QString("Scheduled Deposits (Current Day: %1):\n\n").arg(currentDay);
         for (const auto& dep : scheduled) {
-            QString status = dep.executed ? "EXECUTED" : "PENDING";
-            message += QString("Day %1: $%2 - %3 [%4]\n")
-                           .arg(dep.scheduledDay)
-                           .arg(dep.amount, 0, 'f', 2)
+            QString when = dep.interval > 0
+                ? QString("Every %1 days, day %2-%3").arg(dep.interval).arg(dep.scheduledDay).arg(dep.endDay)
+                : QString("Day %1").arg(dep.scheduledDay);
+            QString status = dep.executed ? "EXECUTED"
+                : (dep.interval > 0 ? QString("NEXT: DAY %1").arg(dep.nextDay) : QString("PENDING"));
+            message += QString("%1: %2$%3 - %4 [%5]\n")
+                           .arg(when)
+                           .arg(dep.withdrawal ? "-" : "")
+                           .arg(dep.amount.toDouble(), 0, 'f', 2)
                            .arg(QString::fromStdString(dep.description))
                            .arg(status);
         }
@@ -878,7 +907,7 @@ void MainWindow::onAdvanceDayClicked() {
     currentDayLabel->setText(QString("Current Day: %1").arg(currentDay));
 
     // Execute scheduled deposits
-    int executed = facade.executeScheduledDeposits(currentDay);
+    int executed = facade.executeScheduledTransfers(currentDay);
     if (executed > 0) {
         QMessageBox::information(this, "Deposits Executed",
                                  QString("Executed %1 scheduled deposit(s) on day %2!").arg(executed).arg(currentDay));
@@ -954,13 +983,19 @@ void MainWindow::onEndSimulationClicked() {
                             "Final Profit: $%1\n"
                             "Total Trades: %2\n"
                             "Days Elapsed: %3\n"
-                            "Extra Days Waited: %4\n\n"
-                            "%5"
-                            ).arg(perf.totalProfit, 0, 'f', 2)
+                            "Extra Days Waited: %4\n"
+                            "Max Drawdown: %5%\n"
+                            "Sharpe Ratio: %6\n"
+                            "Winning Sells: %7%\n\n"
+                            "%8"
+                            ).arg(perf.totalProfit.toDouble(), 0, 'f', 2)
                             .arg(perf.tradesExecuted)
                             .arg(currentDay)
                             .arg(waitDays)
-                            .arg(perf.totalProfit > 0 ? "SUCCESS: Ended with profit!" : "Note: Had to cut some losses.");
+                            .arg(perf.analytics.maxDrawdown * 100.0, 0, 'f', 2)
+                            .arg(perf.analytics.sharpeRatio, 0, 'f', 2)
+                            .arg(perf.successRate, 0, 'f', 1)
+                            .arg(perf.totalProfit > Money() ? "SUCCESS: Ended with profit!" : "Note: Had to cut some losses.");
 
     QMessageBox::information(this, "Simulation Results", resultMsg);
 
@@ -998,8 +1033,8 @@ void MainWindow::onResetSimulationClicked() {
     refreshMarketData();
     refreshPortfolio();
     refreshTradingStats();
-    transactionDisplay->clear();
-    tradeHistoryDisplay->clear();
+    transactionModel->reload();
+    tradeHistoryModel->reload();
 
     QMessageBox::information(this, "Reset Complete",
                              "Simulation has been reset.\n\n"
@@ -1027,83 +1062,33 @@ void MainWindow::updateUIState() {
 
 void MainWindow::refreshBalance() {
     BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    double balance = facade.getBalance();
+    double balance = facade.getBalance().toDouble();
     balanceLabel->setText(QString("Balance: $%1").arg(balance, 0, 'f', 2));
 }
 
 void MainWindow::refreshTransactionHistory() {
-    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    vector<BankingTradingFacade::SimpleTransaction> transactions = facade.getTransactionHistory();
-
-    transactionDisplay->clear();
-
-    if (transactions.empty()) {
-        transactionDisplay->setPlainText("No transactions yet.");
-        return;
-    }
-
-    QString history = QString("=== TRANSACTIONS (%1) ===\n\n").arg(transactions.size());
-
-    for (const auto& trans : transactions) {
-        history += QString("%1 | Day %2 | $%3 | %4\n")
-        .arg(QString::fromStdString(trans.type), -15)
-            .arg(trans.day, 3)
-            .arg(trans.amount, 10, 'f', 2)
-            .arg(QString::fromStdString(trans.description));
+    // The model fetches only the rows on screen, so long histories aren't copied whole
+    int shownTransactions = transactionModel->rowCount();
+    transactionModel->refresh();
+    if (transactionModel->rowCount() != shownTransactions) {
+        transactionTable->scrollToBottom();
     }
-
-    transactionDisplay->setPlainText(history);
 }
 
 void MainWindow::refreshMarketData() {
-    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    vector<BankingTradingFacade::SimpleStockInfo> stocks = facade.getMarketData();
-
-    stockMarketTable->setRowCount(stocks.size());
-
-    int row = 0;
-    for (const auto& stock : stocks) {
-        stockMarketTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(stock.symbol)));
-        stockMarketTable->setItem(row, 1, new QTableWidgetItem(QString::fromStdString(stock.name)));
-        stockMarketTable->setItem(row, 2, new QTableWidgetItem(QString("$%1").arg(stock.currentPrice, 0, 'f', 2)));
-
-
-
-        row++;
-    }
-
-    stockMarketTable->resizeColumnsToContents();
+    marketModel->refresh();
 }
 
 void MainWindow::refreshPortfolio() {
-    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    vector<BankingTradingFacade::SimplePortfolioItem> holdings = facade.getPortfolio();
-
-    portfolioTable->setRowCount(holdings.size());
-
-    int row = 0;
-    for (const auto& h : holdings) {
-        portfolioTable->setItem(row, 0, new QTableWidgetItem(QString::fromStdString(h.symbol)));
-        portfolioTable->setItem(row, 1, new QTableWidgetItem(QString::number(h.shares)));
-        portfolioTable->setItem(row, 2, new QTableWidgetItem(QString("$%1").arg(h.averagePrice, 0, 'f', 2)));
-        portfolioTable->setItem(row, 3, new QTableWidgetItem(QString("$%1").arg(h.currentValue, 0, 'f', 2)));
-
-        QTableWidgetItem* profitItem = new QTableWidgetItem(QString("$%1").arg(h.profit, 0, 'f', 2));
-        profitItem->setForeground(h.profit >= 0 ? Qt::darkGreen : Qt::red);
-        portfolioTable->setItem(row, 4, profitItem);
-
-        row++;
-    }
-
-    portfolioTable->resizeColumnsToContents();
+    portfolioModel->refresh();
 }
 
 void MainWindow::refreshTradingStats() {
     BankingTradingFacade& facade = BankingTradingFacade::getInstance();
     BankingTradingFacade::PerformanceSummary performance = facade.getPerformance();
 
-    totalProfitLabel->setText(QString("$%1").arg(performance.totalProfit, 0, 'f', 2));
-    totalProfitLabel->setStyleSheet(performance.totalProfit >= 0 ? "font-weight: bold; color: green;" : "font-weight: bold; color: red;");
+    totalProfitLabel->setText(QString("$%1").arg(performance.totalProfit.toDouble(), 0, 'f', 2));
+    totalProfitLabel->setStyleSheet(performance.totalProfit >= Money() ? "font-weight: bold; color: green;" : "font-weight: bold; color: red;");
 
     totalSharesLabel->setText(QString::number(performance.totalShares));
     daysElapsedLabel->setText(QString::number(currentDay));
@@ -1116,24 +1101,28 @@ void MainWindow::refreshTradingStats() {
 }
 
 void MainWindow::refreshTradeHistory() {
-    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
-    vector<BankingTradingFacade::SimpleTradeRecord> trades = facade.getTradeHistory();
-
-    QString history;
-    if (trades.empty()) {
-        history = "No trades yet.";
-    } else {
-        for (const auto& t : trades) {
-            history += QString("[Day %1] %2 %3 x%4 @ $%5 = $%6 (%7)\n")
-            .arg(t.day)
-                .arg(QString::fromStdString(t.type))
-                .arg(QString::fromStdString(t.symbol))
-                .arg(t.shares)
-                .arg(t.price, 0, 'f', 2)
-                .arg(t.total, 0, 'f', 2)
-                .arg(QString::fromStdString(t.reason));
-        }
+    // New trades are appended; keep the newest in view
+    int shownTrades = tradeHistoryModel->rowCount();
+    tradeHistoryModel->refresh();
+    if (tradeHistoryModel->rowCount() != shownTrades) {
+        tradeHistoryTable->scrollToBottom();
     }
+}
 
-    tradeHistoryDisplay->setPlainText(history);
+// Read-only table over one of the models. Rows have a fixed height and columns
+// are sized from the first rows whenever the model is reset, so showing a table
+// never measures every row.
+QTableView *MainWindow::createTableView(QAbstractItemModel *model) {
+    QTableView *view = new QTableView();
+    view->setModel(model);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setWordWrap(false);
+    view->horizontalHeader()->setStretchLastSection(true);
+    view->horizontalHeader()->setResizeContentsPrecision(100);
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->verticalHeader()->setDefaultSectionSize(view->fontMetrics().height() + 10);
+
+    connect(model, &QAbstractItemModel::modelReset, view, &QTableView::resizeColumnsToContents);
+    return view;
 }
@@ -11,13 +11,15 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QTabWidget>
 #include <QSpinBox>
 #include <QDoubleSpinBox>
+#include <QCheckBox>
 #include <QMessageBox>
 #include <QScrollArea>
 #include "BankingTradingFacade.h"
+#include "TableModels.h"
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -62,6 +64,7 @@ private:
     void refreshPortfolio();
     void refreshTradingStats();
     void refreshTradeHistory();
+    QTableView *createTableView(QAbstractItemModel *model);
     
     // Main layout components
     QWidget *centralWidget;
@@ -95,12 +98,16 @@ private:
     QPushButton *withdrawButton;
     
     QPushButton *viewTransactionsButton;
-    QTextEdit *transactionDisplay;
+    QTableView *transactionTable;
+    TransactionHistoryModel *transactionModel;
     
     // Scheduled Deposits
     QDoubleSpinBox *scheduledDepositAmount;
     QLineEdit *scheduledDepositDescription;
     QSpinBox *scheduledDepositDay;
+    QSpinBox *scheduledRepeatDays;      // 0 = once
+    QSpinBox *scheduledUntilDay;
+    QCheckBox *scheduledWithdrawal;
     QPushButton *scheduleDepositButton;
     QPushButton *viewScheduledButton;
     
@@ -110,8 +117,10 @@ private:
     
     // Trading Page Components
     QWidget *tradingPage;
-    QTableWidget *stockMarketTable;
-    QTableWidget *portfolioTable;
+    QTableView *stockMarketTable;
+    QTableView *portfolioTable;
+    MarketTableModel *marketModel;
+    PortfolioTableModel *portfolioModel;
     QPushButton *startBotButton;
     QPushButton *stopBotButton;
     QPushButton *refreshMarketButton;
@@ -123,7 +132,8 @@ private:
     QLabel *totalProfitLabel;
     QLabel *totalSharesLabel;
     QLabel *daysElapsedLabel;
-    QTextEdit *tradeHistoryDisplay;
+    QTableView *tradeHistoryTable;
+    TradeHistoryModel *tradeHistoryModel;
     
     // Current day tracker
     int currentDay;
@@ -0,0 +1,67 @@
+// Money.h
+// Fixed-point amount of money in micro-units (1e-6 of a dollar) held in an int64.
+// Sums of Money are exact, so balances, costs and profits don't drift over
+// millions of trades and totals don't depend on the order they were added in.
+// Market prices stay double; they become Money when a trade is booked.
+
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+class Money {
+public:
+    static const int64_t kMicrosPerUnit = 1000000;
+
+    constexpr Money() : micros_(0) {}
+
+    static constexpr Money fromMicros(int64_t micros) { return Money(micros); }
+    static constexpr Money units(int64_t whole) { return Money(whole * kMicrosPerUnit); }
+
+    // Nearest micro-unit
+    static Money fromDouble(double amount) {
+        return Money(std::llround(amount * kMicrosPerUnit));
+    }
+
+    constexpr int64_t micros() const { return micros_; }
+    constexpr double toDouble() const { return (double)micros_ / kMicrosPerUnit; }
+
+    // Arithmetic
+    constexpr Money operator-() const { return Money(-micros_); }
+    constexpr Money operator+(Money other) const { return Money(micros_ + other.micros_); }
+    constexpr Money operator-(Money other) const { return Money(micros_ - other.micros_); }
+    constexpr Money operator*(int64_t count) const { return Money(micros_ * count); }
+
+    // Split into `count` equal parts, rounded to the nearest micro-unit
+    Money operator/(int64_t count) const {
+        if (count == 0) return Money();
+        int64_t quotient = micros_ / count;
+        int64_t remainder = micros_ % count;
+        if (2 * std::llabs(remainder) >= std::llabs(count)) {
+            quotient += ((micros_ < 0) == (count < 0)) ? 1 : -1;
+        }
+        return Money(quotient);
+    }
+
+    Money& operator+=(Money other) { micros_ += other.micros_; return *this; }
+    Money& operator-=(Money other) { micros_ -= other.micros_; return *this; }
+
+    // Comparison
+    constexpr bool operator==(Money other) const { return micros_ == other.micros_; }
+    constexpr bool operator!=(Money other) const { return micros_ != other.micros_; }
+    constexpr bool operator<(Money other) const { return micros_ < other.micros_; }
+    constexpr bool operator<=(Money other) const { return micros_ <= other.micros_; }
+    constexpr bool operator>(Money other) const { return micros_ > other.micros_; }
+    constexpr bool operator>=(Money other) const { return micros_ >= other.micros_; }
+
+private:
+    explicit constexpr Money(int64_t micros) : micros_(micros) {}
+
+    int64_t micros_;
+};
+
+inline constexpr Money operator*(int64_t count, Money amount) { return amount * count; }
+
+#endif // MONEY_H
@@ -0,0 +1,112 @@
+// MonteCarloEngine.cpp
+// Implementation of the parallel Monte Carlo backtesting engine
+
+#include "MonteCarloEngine.h"
+#include "WorkStealingPool.h"
+#include <cmath>
+#include <cstdio>
+#include <ostream>
+
+SimulationOutcome MonteCarloEngine::runOne(const MonteCarloConfig& config, uint64_t seed) {
+    // Private bank with a single logged-in account for this path
+    BankingSystem bank;
+    bank.registerUser("montecarlo", "", config.initialBalance);
+    bank.login("montecarlo", "");
+
+    TradingBot bot(bank, seed);
+    if (!config.universe.empty()) {
+        bot.loadUniverse(config.universe);
+    }
+    bot.setAutoSwitch(config.strategy == "auto");
+    bot.setStrategy(config.strategy == "aggressive" ? "Aggressive" : "Conservative");
+    bot.startBot();
+
+    for (int day = 0; day < config.days; day++) {
+        bot.advanceDay();
+        bot.executeTradingCycle();
+    }
+
+    SimulationOutcome outcome;
+    outcome.seed = seed;
+    outcome.finalProfit = bot.getProfit().toDouble();
+    outcome.maxDrawdown = bot.getPerformanceStats().maxDrawdown;
+    outcome.trades = bot.getTradeCount();
+    return outcome;
+}
+
+MonteCarloReport MonteCarloEngine::run(const MonteCarloConfig& config) {
+    MonteCarloReport report;
+    report.simulations = std::max(0, config.simulations);
+    report.outcomes.resize(report.simulations);
+
+    // Derive well-separated per-path seeds from the base seed
+    RandomSource seeds(config.seed);
+    std::vector<uint64_t> pathSeeds(report.simulations);
+    for (auto& s : pathSeeds) {
+        s = seeds.next();
+    }
+
+    WorkStealingPool pool(config.threads);
+    pool.parallelFor(report.simulations, [&](size_t i) {
+        report.outcomes[i] = runOne(config, pathSeeds[i]);
+    });
+
+    std::vector<double> profits, drawdowns, trades;
+    profits.reserve(report.simulations);
+    drawdowns.reserve(report.simulations);
+    trades.reserve(report.simulations);
+    for (const auto& outcome : report.outcomes) {
+        profits.push_back(outcome.finalProfit);
+        drawdowns.push_back(outcome.maxDrawdown);
+        trades.push_back(outcome.trades);
+    }
+
+    report.profit = summarize(profits);
+    report.drawdown = summarize(drawdowns);
+    report.trades = summarize(trades);
+    return report;
+}
+
+DistributionStats MonteCarloEngine::summarize(std::vector<double> values) {
+    DistributionStats stats = {0, 0, 0, 0, 0, 0, 0};
+    if (values.empty()) return stats;
+
+    std::sort(values.begin(), values.end());
+
+    double sum = 0.0;
+    for (double v : values) sum += v;
+    stats.mean = sum / values.size();
+
+    double squares = 0.0;
+    for (double v : values) squares += (v - stats.mean) * (v - stats.mean);
+    stats.stddev = values.size() > 1 ? std::sqrt(squares / (values.size() - 1)) : 0.0;
+
+    // nearest-rank percentile
+    auto percentile = [&values](double p) {
+        size_t rank = (size_t)std::ceil(p * values.size());
+        return values[rank == 0 ? 0 : rank - 1];
+    };
+
+    stats.min = values.front();
+    stats.p05 = percentile(0.05);
+    stats.median = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.max = values.back();
+    return stats;
+}
+
+void MonteCarloEngine::writeSummaryCsv(std::ostream& out, const MonteCarloReport& report) {
+    out << "metric,simulations,mean,stddev,min,p05,median,p95,max\n";
+
+    auto row = [&](const char* name, const DistributionStats& s) {
+        char line[512];
+        std::snprintf(line, sizeof(line), "%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+                      name, report.simulations, s.mean, s.stddev, s.min,
+                      s.p05, s.median, s.p95, s.max);
+        out << line;
+    };
+
+    row("final_profit", report.profit);
+    row("max_drawdown", report.drawdown);
+    row("trades", report.trades);
+}
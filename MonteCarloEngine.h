@@ -0,0 +1,66 @@
+// MonteCarloEngine.h
+// Runs many independent trading simulations in parallel and summarizes the
+// distribution of outcomes. Each simulation owns its bank, bot and random
+// source, so no singleton state is shared between runs.
+
+#ifndef MONTECARLOENGINE_H
+#define MONTECARLOENGINE_H
+
+#include "TradingBot.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct MonteCarloConfig {
+    int simulations = 1000;
+    int days = 252;
+    uint64_t seed = 42;
+    std::string strategy = "auto";     // "auto", "aggressive" or "conservative"
+    Money initialBalance = Money::units(10000);
+    std::vector<StockListing> universe; // empty keeps the bot's built-in tickers
+    unsigned threads = 0;               // 0 = all hardware threads
+};
+
+// Result of a single simulated path
+struct SimulationOutcome {
+    uint64_t seed;
+    double finalProfit;
+    double maxDrawdown;   // largest peak-to-trough drop in equity, as a fraction
+    int trades;
+};
+
+struct DistributionStats {
+    double mean;
+    double stddev;
+    double min;
+    double p05;
+    double median;
+    double p95;
+    double max;
+};
+
+struct MonteCarloReport {
+    int simulations;
+    DistributionStats profit;
+    DistributionStats drawdown;
+    DistributionStats trades;
+    std::vector<SimulationOutcome> outcomes;
+};
+
+class MonteCarloEngine {
+public:
+    // Run config.simulations paths across the worker pool
+    MonteCarloReport run(const MonteCarloConfig& config);
+
+    // Run one path with its own bank and bot
+    static SimulationOutcome runOne(const MonteCarloConfig& config, uint64_t seed);
+
+    // Summary statistics of a sample (sorts the sample)
+    static DistributionStats summarize(std::vector<double> values);
+
+    // Write the distribution summary as CSV (one row per metric)
+    static void writeSummaryCsv(std::ostream& out, const MonteCarloReport& report);
+};
+
+#endif // MONTECARLOENGINE_H
@@ -0,0 +1,154 @@
+// ParameterSweep.cpp
+// Implementation of the parallel strategy parameter sweep
+
+#include "ParameterSweep.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+
+SweepResult ParameterSweep::evaluate(const SweepConfig& config, const std::vector<StockListing>& universe,
+                                     const std::vector<PricePath>& paths,
+                                     const std::string& strategy, const StrategyParams& params) {
+    SweepResult result;
+    result.strategy = strategy;
+    result.params = params;
+    result.meanDrawdown = 0.0;
+    result.meanTrades = 0.0;
+
+    bool autoSwitch = (strategy == "auto");
+    std::string name = (strategy == "aggressive") ? "Aggressive" : "Conservative";
+
+    // exact totals, averaged once at the end
+    Money totalProfit;
+    Money worstProfit;
+
+    for (size_t p = 0; p < paths.size(); p++) {
+        const PricePath& path = paths[p];
+
+        BankingSystem bank;
+        bank.registerUser("sweep", "", config.initialBalance);
+        bank.login("sweep", "");
+
+        TradingBot bot(bank, config.seed + p);
+        if (!config.universe.empty()) {
+            bot.loadUniverse(universe);
+        }
+        bot.setStrategyParams("Aggressive", params);
+        bot.setStrategyParams("Conservative", params);
+        bot.setAutoSwitch(autoSwitch);
+        bot.setStrategy(name);
+        bot.startBot();
+
+        for (int day = 1; day <= path.getDays(); day++) {
+            bot.advanceDayTo(path.pricesOn(day));
+            bot.executeTradingCycle();
+        }
+
+        Money profit = bot.getProfit();
+        totalProfit += profit;
+        worstProfit = (p == 0) ? profit : std::min(worstProfit, profit);
+        result.meanDrawdown += bot.getPerformanceStats().maxDrawdown;
+        result.meanTrades += bot.getTradeCount();
+    }
+
+    result.meanProfit = paths.empty() ? 0.0 : totalProfit.toDouble() / paths.size();
+    result.worstProfit = worstProfit.toDouble();
+    if (!paths.empty()) {
+        result.meanDrawdown /= paths.size();
+        result.meanTrades /= paths.size();
+    }
+    return result;
+}
+
+std::vector<SweepResult> ParameterSweep::run(const SweepConfig& config) {
+    const std::vector<StockListing> universe =
+        config.universe.empty() ? StockMarket::defaultUniverse() : config.universe;
+
+    // Expand the grid
+    std::vector<std::pair<std::string, StrategyParams>> points;
+    for (const auto& strategy : config.grid.strategies) {
+        for (double takeProfit : config.grid.takeProfits) {
+            for (double stopLoss : config.grid.stopLosses) {
+                for (int maxHoldings : config.grid.maxHoldings) {
+                    points.push_back({strategy, {takeProfit, stopLoss, maxHoldings}});
+                }
+            }
+        }
+    }
+
+    WorkStealingPool pool(config.threads);
+
+    // One shared path per seed, generated in parallel
+    std::vector<PricePath> paths(std::max(0, config.paths));
+    pool.parallelFor(paths.size(), [&](size_t p) {
+        paths[p] = PricePath::generate(universe, config.days, config.seed + p);
+    });
+
+    std::vector<SweepResult> results(points.size());
+    pool.parallelFor(points.size(), [&](size_t i) {
+        results[i] = evaluate(config, universe, paths, points[i].first, points[i].second);
+    });
+
+    std::stable_sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+        return a.meanProfit > b.meanProfit;
+    });
+    return results;
+}
+
+bool ParameterSweep::parseValues(const std::string& text, std::vector<double>& values) {
+    values.clear();
+    char* end = nullptr;
+
+    size_t colon = text.find(':');
+    if (colon != std::string::npos) {
+        size_t second = text.find(':', colon + 1);
+        if (second == std::string::npos) return false;
+
+        double start = std::strtod(text.c_str(), &end);
+        if (*end != ':') return false;
+        double stop = std::strtod(text.c_str() + colon + 1, &end);
+        if (*end != ':') return false;
+        double step = std::strtod(text.c_str() + second + 1, &end);
+        if (*end != '\0' || step == 0 || (stop - start) / step < 0) return false;
+
+        // inclusive of stop, tolerant of rounding in the step
+        long count = (long)std::floor((stop - start) / step + 1e-9) + 1;
+        for (long i = 0; i < count; i++) {
+            values.push_back(start + i * step);
+        }
+        return true;
+    }
+
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t comma = text.find(',', begin);
+        if (comma == std::string::npos) comma = text.size();
+
+        std::string item = text.substr(begin, comma - begin);
+        double value = std::strtod(item.c_str(), &end);
+        if (item.empty() || *end != '\0') return false;
+        values.push_back(value);
+
+        begin = comma + 1;
+    }
+    return !values.empty();
+}
+
+void ParameterSweep::writeCsv(std::ostream& out, const std::vector<SweepResult>& results, size_t top) {
+    out << "rank,strategy,take_profit,stop_loss,max_holdings,mean_profit,worst_profit,"
+           "mean_drawdown,mean_trades\n";
+
+    size_t rows = (top == 0) ? results.size() : std::min(top, results.size());
+    char line[512];
+    for (size_t i = 0; i < rows; i++) {
+        const SweepResult& r = results[i];
+        std::snprintf(line, sizeof(line), "%zu,%s,%.4f,%.4f,%d,%.2f,%.2f,%.4f,%.1f\n",
+                      i + 1, r.strategy.c_str(), r.params.takeProfit, r.params.stopLoss,
+                      r.params.maxHoldings, r.meanProfit, r.worstProfit,
+                      r.meanDrawdown, r.meanTrades);
+        out << line;
+    }
+}
@@ -0,0 +1,60 @@
+// ParameterSweep.h
+// Grid search over strategy thresholds (take-profit, stop-loss, max holdings).
+// One price path is generated per seed and shared by every parameter set, and
+// the parameter sets are evaluated in parallel.
+
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include "PricePath.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Values to try for each parameter; every combination is evaluated
+struct SweepGrid {
+    std::vector<std::string> strategies = {"aggressive", "conservative"};  // or "auto"
+    std::vector<double> takeProfits = {0.05, 0.10, 0.15};
+    std::vector<double> stopLosses = {-0.03, -0.05, -0.10};
+    std::vector<int> maxHoldings = {3, 5};
+};
+
+struct SweepConfig {
+    SweepGrid grid;
+    int days = 252;
+    int paths = 4;                      // price paths (seeds) per parameter set
+    uint64_t seed = 42;
+    Money initialBalance = Money::units(10000);
+    std::vector<StockListing> universe; // empty uses the bot's built-in tickers
+    unsigned threads = 0;               // 0 = all hardware threads
+};
+
+// Averages over all paths for one parameter set
+struct SweepResult {
+    std::string strategy;
+    StrategyParams params;
+    double meanProfit;
+    double worstProfit;
+    double meanDrawdown;
+    double meanTrades;
+};
+
+class ParameterSweep {
+public:
+    // Evaluate every grid point; results are sorted best mean profit first
+    std::vector<SweepResult> run(const SweepConfig& config);
+
+    // Parse "start:stop:step" (inclusive) or "a,b,c". Returns false on bad input.
+    static bool parseValues(const std::string& text, std::vector<double>& values);
+
+    // Write the ranked table as CSV (top == 0 writes every row)
+    static void writeCsv(std::ostream& out, const std::vector<SweepResult>& results, size_t top);
+
+private:
+    static SweepResult evaluate(const SweepConfig& config, const std::vector<StockListing>& universe,
+                                const std::vector<PricePath>& paths,
+                                const std::string& strategy, const StrategyParams& params);
+};
+
+#endif // PARAMETERSWEEP_H
@@ -0,0 +1,42 @@
+// PasswordHash.h
+// Salted SHA-256 of an account password. Accounts keep only this, so the
+// journal, snapshots and checkpoints never hold a password in the clear.
+// Stored form: 16 random salt bytes followed by SHA-256(salt + password).
+
+#ifndef PASSWORDHASH_H
+#define PASSWORDHASH_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class PasswordHash {
+public:
+    static const size_t kSaltSize = 16;
+    static const size_t kDigestSize = 32;
+    static const size_t kSize = kSaltSize + kDigestSize;
+
+    // Matches no password
+    PasswordHash() : bytes_{}, valid_(false) {}
+
+    // Hash `password` under a fresh random salt
+    static PasswordHash create(const std::string& password);
+
+    // Read a stored hash; false unless `bytes` is exactly kSize long
+    static bool fromBytes(std::string_view bytes, PasswordHash& hash);
+
+    // Compares the whole digest whatever the first difference, so the time
+    // taken doesn't tell how close a guess was
+    bool matches(const std::string& password) const;
+
+    std::string_view bytes() const { return std::string_view((const char*)bytes_.data(), kSize); }
+
+private:
+    static void digest(const uint8_t* salt, const std::string& password, uint8_t* out);
+
+    std::array<uint8_t, kSize> bytes_;
+    bool valid_;
+};
+
+#endif // PASSWORDHASH_H
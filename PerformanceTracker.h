@@ -0,0 +1,216 @@
+// PerformanceTracker.h
+// Streaming performance analytics for one trading account. Each market day
+// adds one equity sample and each trade one result; every statistic (return
+// moments, Sharpe/Sortino, drawdown, win/loss) is kept up to date with O(1)
+// work per update, so reading them never walks the history.
+//
+// Returns are time-weighted: cash that moved between two samples without a
+// trade (deposits, withdrawals, scheduled transfers) is an external flow and
+// is added to the starting equity of that period instead of counting as gain
+// or loss. Drawdown follows the same flow-adjusted growth.
+
+#ifndef PERFORMANCETRACKER_H
+#define PERFORMANCETRACKER_H
+
+#include "Money.h"
+#include "TimeSeriesStore.h"
+#include <cmath>
+#include <cstdint>
+
+// Everything a dashboard shows, as of the last update
+struct PerformanceStats {
+    int days;                  // equity samples so far
+    double startingEquity;     // first sample
+    double equity;             // latest sample
+    double peakEquity;
+    double netFlows;           // deposits less withdrawals since the first sample
+    double timeWeightedReturn; // growth since the first sample net of flows, as a fraction
+    double drawdown;           // current drop of the growth from its peak, as a fraction
+    double maxDrawdown;        // largest drop from a previous peak, as a fraction
+
+    // Daily returns (fractions); ratios are annualized over 252 trading days
+    // with a zero risk-free rate and are 0 until there are two returns.
+    // A return spanning unsampled market days is left out of these, but still
+    // counts towards the growth and drawdown.
+    int gapDays;               // market days between samples that were never sampled
+    double meanReturn;
+    double volatility;         // sample standard deviation
+    double downsideDeviation;  // root mean square of the negative returns
+    double sharpeRatio;
+    double sortinoRatio;
+
+    int trades;
+    int buys;
+    int sells;
+    int wins;                  // sells that realized a profit
+    int losses;                // sells that realized a loss
+    double winRate;            // wins per sell, as a percentage
+    double grossProfit;        // realized on winning sells
+    double grossLoss;          // realized on losing sells (positive)
+    double largestWin;
+    double largestLoss;        // positive
+};
+
+class PerformanceTracker {
+public:
+    // Running sums behind the statistics. Plain data, so checkpoints can
+    // store it as is (see SimulationCheckpoint).
+    struct Totals {
+        int32_t lastDay;       // market day of the latest sample, -1 before the first
+        int32_t days;
+        double startingEquity;
+        double equity;
+        double peakEquity;
+        int64_t cash;          // account cash at the latest sample, in micro-units
+        int64_t tradedCash;    // net cash moved by trades since then, in micro-units
+        double netFlows;
+        double growth;         // time-weighted growth factor, 1 at the first sample
+        double peakGrowth;
+        double maxDrawdown;
+        int32_t gapDays;
+        int64_t returns;       // single-day returns seen
+        double meanReturn;     // Welford running mean and sum of squared deviations
+        double squaredDeviations;
+        double downsideSquares;
+        int32_t trades;
+        int32_t buys;
+        int32_t sells;
+        int32_t wins;
+        int32_t losses;
+        double grossProfit;
+        double grossLoss;
+        double largestWin;
+        double largestLoss;
+    };
+
+    PerformanceTracker() { reset(); }
+
+    PerformanceTracker(const Totals& totals, const CompressedSeries& equityCurve)
+        : totals_(totals), equityCurve_(equityCurve) {}
+
+    void reset() {
+        totals_ = Totals();
+        totals_.lastDay = -1;
+        equityCurve_.clear();
+    }
+
+    // Cash and holdings at the end of a market day. Only the first sample for a
+    // day counts, so extra trading cycles on the same day don't distort the
+    // returns. Any change in cash since the last sample that trades don't
+    // explain is taken as an external flow at the start of the period.
+    void recordDay(int day, Money cash, Money holdingsValue) {
+        Totals& t = totals_;
+        if (day == t.lastDay) return;
+
+        double equity = (cash + holdingsValue).toDouble();
+
+        if (t.days == 0) {
+            t.startingEquity = equity;
+            t.peakEquity = equity;
+            t.growth = 1.0;
+            t.peakGrowth = 1.0;
+        } else {
+            double flow = Money::fromMicros(cash.micros() - t.cash - t.tradedCash).toDouble();
+            double invested = t.equity + flow;
+            t.netFlows += flow;
+
+            if (invested > 0) {
+                double r = equity / invested - 1.0;
+                t.growth *= 1.0 + r;
+
+                if (day - t.lastDay == 1) {
+                    t.returns++;
+                    double delta = r - t.meanReturn;
+                    t.meanReturn += delta / t.returns;
+                    t.squaredDeviations += delta * (r - t.meanReturn);
+                    if (r < 0) t.downsideSquares += r * r;
+                }
+            }
+            if (day - t.lastDay > 1) t.gapDays += day - t.lastDay - 1;
+        }
+
+        if (equity > t.peakEquity) t.peakEquity = equity;
+        if (t.growth > t.peakGrowth) {
+            t.peakGrowth = t.growth;
+        } else if (t.peakGrowth > 0 && (t.peakGrowth - t.growth) / t.peakGrowth > t.maxDrawdown) {
+            t.maxDrawdown = (t.peakGrowth - t.growth) / t.peakGrowth;
+        }
+
+        t.equity = equity;
+        t.cash = cash.micros();
+        t.tradedCash = 0;
+        t.lastDay = day;
+        t.days++;
+        equityCurve_.append(day, equity);
+    }
+
+    void recordBuy(Money cost) {
+        totals_.trades++;
+        totals_.buys++;
+        totals_.tradedCash -= cost.micros();
+    }
+
+    // A sale, the cash it raised and the profit (or loss, negative) it realized
+    // against the cost basis
+    void recordSell(Money revenue, double realizedProfit) {
+        Totals& t = totals_;
+        t.trades++;
+        t.sells++;
+        t.tradedCash += revenue.micros();
+        if (realizedProfit > 0) {
+            t.wins++;
+            t.grossProfit += realizedProfit;
+            if (realizedProfit > t.largestWin) t.largestWin = realizedProfit;
+        } else if (realizedProfit < 0) {
+            t.losses++;
+            t.grossLoss -= realizedProfit;
+            if (-realizedProfit > t.largestLoss) t.largestLoss = -realizedProfit;
+        }
+    }
+
+    PerformanceStats getStats() const {
+        const Totals& t = totals_;
+        const double annualization = std::sqrt(252.0);
+
+        PerformanceStats s;
+        s.days = t.days;
+        s.startingEquity = t.startingEquity;
+        s.equity = t.equity;
+        s.peakEquity = t.peakEquity;
+        s.netFlows = t.netFlows;
+        s.timeWeightedReturn = t.days > 0 ? t.growth - 1.0 : 0.0;
+        s.drawdown = t.peakGrowth > 0 ? (t.peakGrowth - t.growth) / t.peakGrowth : 0.0;
+        s.maxDrawdown = t.maxDrawdown;
+
+        s.gapDays = t.gapDays;
+        s.meanReturn = t.meanReturn;
+        s.volatility = t.returns > 1 ? std::sqrt(t.squaredDeviations / (t.returns - 1)) : 0.0;
+        s.downsideDeviation = t.returns > 0 ? std::sqrt(t.downsideSquares / t.returns) : 0.0;
+        s.sharpeRatio = (t.returns > 1 && s.volatility > 0) ? s.meanReturn / s.volatility * annualization : 0.0;
+        s.sortinoRatio = (t.returns > 1 && s.downsideDeviation > 0)
+            ? s.meanReturn / s.downsideDeviation * annualization : 0.0;
+
+        s.trades = t.trades;
+        s.buys = t.buys;
+        s.sells = t.sells;
+        s.wins = t.wins;
+        s.losses = t.losses;
+        s.winRate = t.sells > 0 ? (double)t.wins / t.sells * 100.0 : 0.0;
+        s.grossProfit = t.grossProfit;
+        s.grossLoss = t.grossLoss;
+        s.largestWin = t.largestWin;
+        s.largestLoss = t.largestLoss;
+        return s;
+    }
+
+    // One equity sample per recorded day, compressed (see CompressedSeries)
+    const CompressedSeries& getEquityCurve() const { return equityCurve_; }
+
+    const Totals& getTotals() const { return totals_; }
+
+private:
+    Totals totals_;
+    CompressedSeries equityCurve_;
+};
+
+#endif // PERFORMANCETRACKER_H
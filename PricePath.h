@@ -0,0 +1,61 @@
+// PricePath.h
+// Pre-generated daily closing prices for a whole universe. Generated once per
+// seed and replayed into any number of bots with TradingBot::advanceDayTo, so
+// comparing many strategies on the same market pays for price generation once.
+
+#ifndef PRICEPATH_H
+#define PRICEPATH_H
+
+#include "TradingBot.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class PricePath {
+private:
+    int days;
+    int tickers;
+    vector<double> prices;   // (days + 1) rows of `tickers` prices, row 0 = opening prices
+
+public:
+    PricePath() : days(0), tickers(0) {}
+
+    // Same moves as TradingBot::advanceDay for a bot seeded with `seed`
+    static PricePath generate(const vector<StockListing>& universe, int days, uint64_t seed) {
+        PricePath path;
+        path.days = days;
+        path.tickers = (int)universe.size();
+        path.prices.resize((size_t)(days + 1) * path.tickers);
+
+        // generators are stateless, so one serves every ticker (as in StockMarket)
+        SimpleStockFactory factory;
+        unique_ptr<StockPriceGenerator> generator(factory.createPriceGenerator());
+        for (int i = 0; i < path.tickers; i++) {
+            path.prices[i] = universe[i].openingPrice;
+        }
+
+        RandomSource rng(seed);
+        for (int day = 1; day <= days; day++) {
+            const double* yesterday = path.pricesOn(day - 1);
+            double* today = &path.prices[(size_t)day * path.tickers];
+
+            for (int i = 0; i < path.tickers; i++) {
+                today[i] = generator->generate(yesterday[i], rng);
+                if (today[i] < 0.01) {
+                    today[i] = 0.01;
+                }
+            }
+        }
+        return path;
+    }
+
+    int getDays() const { return days; }
+    int getTickerCount() const { return tickers; }
+
+    // Prices of every ticker on a day (0 = opening)
+    const double* pricesOn(int day) const {
+        return &prices[(size_t)day * tickers];
+    }
+};
+
+#endif // PRICEPATH_H
@@ -0,0 +1,181 @@
+// ScoringKernel.cpp
+// Scalar, AVX2 and AVX-512 versions of the strategy scoring pass
+
+#include "ScoringKernel.h"
+#include <atomic>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SCORING_KERNEL_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+typedef int (*Kernel)(const double*, const double*, int, PriceMove, double, double*, int32_t*, int32_t*);
+
+const double kMaxShares = 2147483647.0;
+
+// Stocks [start, count) one at a time; also the tail of the vector kernels
+int scoreRange(const double* cur, const double* prev, int start, int count, PriceMove move, double budget,
+               double* scores, int32_t* shares, int32_t* picks, int picked) {
+    for (int i = start; i < count; i++) {
+        bool hit = (move == PriceMove::UP) ? cur[i] > prev[i] : cur[i] < prev[i];
+        scores[i] = hit ? 100.0 : 0.0;
+
+        double affordable = budget / cur[i];
+        int32_t n = (int32_t)(affordable < kMaxShares ? affordable : kMaxShares);
+        shares[i] = n < 1 ? 1 : n;
+
+        picks[picked] = i;
+        picked += hit;
+    }
+    return picked;
+}
+
+int scoreScalar(const double* cur, const double* prev, int count, PriceMove move, double budget,
+                double* scores, int32_t* shares, int32_t* picks) {
+    return scoreRange(cur, prev, 0, count, move, budget, scores, shares, picks, 0);
+}
+
+#ifdef SCORING_KERNEL_X86
+
+// Four stocks per step
+__attribute__((target("avx2")))
+int scoreAvx2(const double* cur, const double* prev, int count, PriceMove move, double budget,
+              double* scores, int32_t* shares, int32_t* picks) {
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d budgets = _mm256_set1_pd(budget);
+    const __m256d maxShares = _mm256_set1_pd(kMaxShares);
+    const __m128i one = _mm_set1_epi32(1);
+    bool up = (move == PriceMove::UP);
+    int picked = 0;
+    int i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256d c = _mm256_loadu_pd(cur + i);
+        __m256d p = _mm256_loadu_pd(prev + i);
+        __m256d hit = up ? _mm256_cmp_pd(c, p, _CMP_GT_OQ) : _mm256_cmp_pd(c, p, _CMP_LT_OQ);
+        _mm256_storeu_pd(scores + i, _mm256_and_pd(hit, hundred));
+
+        __m256d affordable = _mm256_min_pd(_mm256_div_pd(budgets, c), maxShares);
+        __m128i n = _mm_max_epi32(_mm256_cvttpd_epi32(affordable), one);
+        _mm_storeu_si128((__m128i*)(shares + i), n);
+
+        unsigned mask = (unsigned)_mm256_movemask_pd(hit);
+        while (mask) {
+            picks[picked++] = i + __builtin_ctz(mask);
+            mask &= mask - 1;
+        }
+    }
+    return scoreRange(cur, prev, i, count, move, budget, scores, shares, picks, picked);
+}
+
+// Sixteen stocks per step, picks written with a compress-store.
+// (GCC 12 warns about the intrinsics' own undefined pass-through operands.)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__((target("avx512f")))
+int scoreAvx512(const double* cur, const double* prev, int count, PriceMove move, double budget,
+                double* scores, int32_t* shares, int32_t* picks) {
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d budgets = _mm512_set1_pd(budget);
+    const __m512d maxShares = _mm512_set1_pd(kMaxShares);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m512i lanes = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    bool up = (move == PriceMove::UP);
+    int picked = 0;
+    int i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __mmask8 hits[2];
+        for (int half = 0; half < 2; half++) {
+            int j = i + half * 8;
+            __m512d c = _mm512_loadu_pd(cur + j);
+            __m512d p = _mm512_loadu_pd(prev + j);
+            hits[half] = up ? _mm512_cmp_pd_mask(c, p, _CMP_GT_OQ) : _mm512_cmp_pd_mask(c, p, _CMP_LT_OQ);
+            _mm512_storeu_pd(scores + j, _mm512_mask_blend_pd(hits[half], zero, hundred));
+
+            __m512d affordable = _mm512_min_pd(_mm512_div_pd(budgets, c), maxShares);
+            __m256i n = _mm256_max_epi32(_mm512_cvttpd_epi32(affordable), one);
+            _mm256_storeu_si256((__m256i*)(shares + j), n);
+        }
+
+        __mmask16 mask = (__mmask16)(hits[0] | (hits[1] << 8));
+        __m512i indices = _mm512_add_epi32(_mm512_set1_epi32(i), lanes);
+        _mm512_mask_compressstoreu_epi32(picks + picked, mask, indices);
+        picked += __builtin_popcount(mask);
+    }
+    return scoreRange(cur, prev, i, count, move, budget, scores, shares, picks, picked);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif
+
+struct KernelEntry {
+    const char* name;
+    Kernel kernel;
+    bool (*supported)();
+};
+
+bool always() { return true; }
+
+#ifdef SCORING_KERNEL_X86
+bool hasAvx2() { return __builtin_cpu_supports("avx2"); }
+bool hasAvx512() { return __builtin_cpu_supports("avx512f"); }
+#endif
+
+// Fastest first
+const KernelEntry kKernels[] = {
+#ifdef SCORING_KERNEL_X86
+    {"avx512", scoreAvx512, hasAvx512},
+    {"avx2", scoreAvx2, hasAvx2},
+#endif
+    {"scalar", scoreScalar, always},
+};
+
+const KernelEntry* bestKernel() {
+    for (const KernelEntry& entry : kKernels) {
+        if (entry.supported()) return &entry;
+    }
+    return nullptr;  // not reached: scalar is always supported
+}
+
+std::atomic<const KernelEntry*> current(nullptr);
+
+const KernelEntry* currentKernel() {
+    const KernelEntry* entry = current.load(std::memory_order_acquire);
+    if (!entry) {
+        const KernelEntry* best = bestKernel();
+        if (current.compare_exchange_strong(entry, best, std::memory_order_acq_rel)) {
+            entry = best;  // otherwise setScoringKernel got there first and entry holds its choice
+        }
+    }
+    return entry;
+}
+
+}
+
+int scoreStocks(const double* cur, const double* prev, int count, PriceMove move, double budget,
+                double* scores, int32_t* shares, int32_t* picks) {
+    return currentKernel()->kernel(cur, prev, count, move, budget, scores, shares, picks);
+}
+
+const char* getScoringKernel() {
+    return currentKernel()->name;
+}
+
+bool setScoringKernel(const char* name) {
+    for (const KernelEntry& entry : kKernels) {
+        if (std::strcmp(entry.name, name) == 0 && entry.supported()) {
+            current.store(&entry, std::memory_order_release);
+            return true;
+        }
+    }
+    return false;
+}
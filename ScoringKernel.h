@@ -0,0 +1,31 @@
+// ScoringKernel.h
+// The strategies' scoring pass over a market's price columns (see StockTable).
+// One call scores every stock, sizes a position in each and lists the stocks
+// that scored, so ranking a large universe is a single streaming pass over
+// two arrays of doubles. On x86 the pass runs with AVX-512 or AVX2 when the
+// CPU has it (checked once at run time); everywhere else it is plain C++.
+
+#ifndef SCORINGKERNEL_H
+#define SCORINGKERNEL_H
+
+#include <cstdint>
+
+// Which daily move a strategy buys into
+enum class PriceMove { DOWN, UP };
+
+// For every stock i (count of them):
+//   scores[i] = 100 if cur[i] moved `move` from prev[i] (strictly), else 0
+//   shares[i] = (int)(budget / cur[i]), at least 1 and at most INT32_MAX
+//   picks     = the indices i with a score, in increasing order
+// Returns the number of picks. Every output array must hold count entries.
+int scoreStocks(const double* cur, const double* prev, int count, PriceMove move, double budget,
+                double* scores, int32_t* shares, int32_t* picks);
+
+// Kernel used by scoreStocks: "avx512", "avx2" or "scalar"
+const char* getScoringKernel();
+
+// Force a kernel (for benchmarks and comparisons). Returns false, changing
+// nothing, if the name is unknown or this CPU can't run it.
+bool setScoringKernel(const char* name);
+
+#endif // SCORINGKERNEL_H
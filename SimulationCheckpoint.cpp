@@ -0,0 +1,681 @@
+// SimulationCheckpoint.cpp
+// Implementation of simulation checkpoints (POSIX file I/O and mmap)
+
+#include "SimulationCheckpoint.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// File layout (native byte order): u32 magic, u32 version, u32 ledger entry size,
+// then the market, bot and account sections, then u64 history log generation and
+// u64 length. Strings are u32 length + bytes; arrays are a count followed by their
+// elements. A bot's PerformanceTracker totals are stored as their struct.
+const uint32_t kMagic = 0x504B4353;  // "SCKP"
+const uint32_t kVersion = 6;
+
+// History log (RollingCheckpoint): u32 magic, u32 version, u64 generation, then
+// one chunk per bot per save: account, trade count and trades, sample count,
+// sample days and sample values
+const uint32_t kLogMagic = 0x54534853;  // "SHST"
+const uint32_t kLogVersion = 1;
+const size_t kLogHeaderSize = 16;
+
+class Writer {
+public:
+    template <typename T>
+    void put(T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putText(const std::string& text) {
+        put<uint32_t>((uint32_t)text.size());
+        data.insert(data.end(), text.begin(), text.end());
+    }
+
+    // Plain-old-data elements, copied as they are laid out in memory
+    template <typename T>
+    void putArray(const T* values, size_t count) {
+        const char* bytes = reinterpret_cast<const char*>(values);
+        data.insert(data.end(), bytes, bytes + count * sizeof(T));
+    }
+
+    std::vector<char> data;
+};
+
+// Reads from a mapped file. Any read past the end marks the reader as failed
+// and returns zeros, so decoding just checks ok() once at the end.
+class Reader {
+public:
+    Reader(const char* begin, size_t size) : cursor(begin), end(begin + size), failed(false) {}
+
+    bool ok() const { return !failed; }
+    void fail() { failed = true; }
+    bool atEnd() const { return cursor == end; }
+
+    template <typename T>
+    T get() {
+        T value{};
+        if (!take(sizeof(T))) return value;
+        std::memcpy(&value, cursor - sizeof(T), sizeof(T));
+        return value;
+    }
+
+    std::string getText() {
+        uint32_t length = get<uint32_t>();
+        if (!take(length)) return std::string();
+        return std::string(cursor - length, length);
+    }
+
+    template <typename T>
+    void getArray(std::vector<T>& values, size_t count) {
+        if (count > (size_t)(end - cursor) / sizeof(T) || !take(count * sizeof(T))) return;
+        values.resize(count);
+        std::memcpy(values.data(), cursor - count * sizeof(T), count * sizeof(T));
+    }
+
+    // Element count, checked against what is left so a damaged count can't
+    // make the caller reserve gigabytes
+    size_t getCount(size_t minimumElementSize) {
+        uint64_t count = get<uint64_t>();
+        if (count > (uint64_t)(end - cursor) / minimumElementSize) {
+            failed = true;
+            return 0;
+        }
+        return (size_t)count;
+    }
+
+private:
+    bool take(size_t size) {
+        if (failed || (size_t)(end - cursor) < size) {
+            failed = true;
+            return false;
+        }
+        cursor += size;
+        return true;
+    }
+
+    const char* cursor;
+    const char* end;
+    bool failed;
+};
+
+void putParams(Writer& out, const StrategyParams& params) {
+    out.put<double>(params.takeProfit);
+    out.put<double>(params.stopLoss);
+    out.put<int32_t>(params.maxHoldings);
+}
+
+StrategyParams getParams(Reader& in) {
+    StrategyParams params;
+    params.takeProfit = in.get<double>();
+    params.stopLoss = in.get<double>();
+    params.maxHoldings = in.get<int32_t>();
+    return params;
+}
+
+const size_t kMinimumTradeSize = 36;
+
+void writeTrade(Writer& out, const TradeRecords& trade) {
+    out.putText(trade.type);
+    out.putText(trade.ticker_symbol);
+    out.put<int32_t>(trade.shares);
+    out.put<int64_t>(trade.cost.micros());
+    out.put<int64_t>(trade.total.micros());
+    out.put<int32_t>(trade.day);
+    out.putText(trade.reason);
+}
+
+void readTrade(Reader& in, TradeRecords& trade) {
+    trade.type = in.getText();
+    trade.ticker_symbol = in.getText();
+    trade.shares = in.get<int32_t>();
+    trade.cost = Money::fromMicros(in.get<int64_t>());
+    trade.total = Money::fromMicros(in.get<int64_t>());
+    trade.day = in.get<int32_t>();
+    trade.reason = in.getText();
+}
+
+void writeMarket(Writer& out, const MarketState& market) {
+    out.put<int32_t>(market.currentDay);
+    out.put<uint64_t>(market.rngState);
+    out.put<uint64_t>(market.listings.size());
+    for (const auto& listing : market.listings) {
+        out.putText(listing.ticker_symbol);
+        out.putText(listing.name);
+        out.put<double>(listing.openingPrice);
+    }
+    out.putArray(market.cur.data(), market.cur.size());
+    out.putArray(market.prev.data(), market.prev.size());
+}
+
+void readMarket(Reader& in, MarketState& market) {
+    market.currentDay = in.get<int32_t>();
+    market.rngState = in.get<uint64_t>();
+
+    size_t count = in.getCount(16);
+    market.listings.resize(count);
+    for (auto& listing : market.listings) {
+        listing.ticker_symbol = in.getText();
+        listing.name = in.getText();
+        listing.openingPrice = in.get<double>();
+    }
+    in.getArray(market.cur, count);
+    in.getArray(market.prev, count);
+}
+
+void writeBot(Writer& out, const BotState& bot) {
+    out.putText(bot.account);
+    out.put<uint8_t>(bot.running);
+    out.put<uint8_t>(bot.autoSwitch);
+    out.put<int64_t>(bot.realizedProfit.micros());
+    out.putText(bot.marketCondition);
+    out.putText(bot.strategy);
+    putParams(out, bot.aggressiveParams);
+    putParams(out, bot.conservativeParams);
+
+    out.put<uint64_t>(bot.portfolio.size());
+    for (const auto& holding : bot.portfolio) {
+        out.putText(holding.ticker_symbol);
+        out.put<int32_t>(holding.shares);
+        out.put<int64_t>(holding.averageCost.micros());
+        out.put<int64_t>(holding.totalCost.micros());
+    }
+
+    out.put<uint64_t>(bot.history.size());
+    for (const auto& trade : bot.history) {
+        writeTrade(out, trade);
+    }
+
+    out.put<uint64_t>(bot.rankings.size());
+    for (const auto& rank : bot.rankings) {
+        out.putText(rank.ticker_symbol);
+        out.put<double>(rank.cur);
+        out.put<double>(rank.score);
+        out.put<int32_t>(rank.recommendedShares);
+    }
+
+    // the equity curve as plain (day, value) columns; it is re-encoded on load
+    std::vector<int32_t> days;
+    std::vector<double> equity;
+    const CompressedSeries& curve = bot.performance.getEquityCurve();
+    days.reserve(curve.size());
+    equity.reserve(curve.size());
+    curve.forEachInRange(curve.getFirstDay(), curve.getLastDay(), [&](int day, double value) {
+        days.push_back(day);
+        equity.push_back(value);
+    });
+    out.put<PerformanceTracker::Totals>(bot.performance.getTotals());
+    out.put<uint64_t>(days.size());
+    out.putArray(days.data(), days.size());
+    out.putArray(equity.data(), equity.size());
+}
+
+void readBot(Reader& in, BotState& bot) {
+    bot.account = in.getText();
+    bot.running = in.get<uint8_t>() != 0;
+    bot.autoSwitch = in.get<uint8_t>() != 0;
+    bot.realizedProfit = Money::fromMicros(in.get<int64_t>());
+    bot.marketCondition = in.getText();
+    bot.strategy = in.getText();
+    bot.aggressiveParams = getParams(in);
+    bot.conservativeParams = getParams(in);
+
+    bot.portfolio.resize(in.getCount(24));
+    for (auto& holding : bot.portfolio) {
+        holding.ticker_symbol = in.getText();
+        holding.shares = in.get<int32_t>();
+        holding.averageCost = Money::fromMicros(in.get<int64_t>());
+        holding.totalCost = Money::fromMicros(in.get<int64_t>());
+    }
+
+    bot.history.resize(in.getCount(kMinimumTradeSize));
+    for (auto& trade : bot.history) {
+        readTrade(in, trade);
+    }
+
+    bot.rankings.resize(in.getCount(24));
+    for (auto& rank : bot.rankings) {
+        rank.ticker_symbol = in.getText();
+        rank.cur = in.get<double>();
+        rank.score = in.get<double>();
+        rank.recommendedShares = in.get<int32_t>();
+    }
+
+    PerformanceTracker::Totals totals = in.get<PerformanceTracker::Totals>();
+    size_t samples = in.getCount(sizeof(int32_t) + sizeof(double));
+    std::vector<int32_t> days;
+    std::vector<double> equity;
+    in.getArray(days, samples);
+    in.getArray(equity, samples);
+
+    CompressedSeries curve;
+    for (size_t i = 0; i < days.size() && i < equity.size(); i++) {
+        curve.append(days[i], equity[i]);
+    }
+    bot.performance = PerformanceTracker(totals, curve);
+}
+
+void writeAccount(Writer& out, const AccountSnapshot& account) {
+    out.putText(account.username);
+    out.putText(std::string(account.password.bytes()));
+    out.put<int64_t>(account.balance.micros());
+
+    out.put<uint64_t>(account.descriptions.size());
+    for (const auto& description : account.descriptions) {
+        out.putText(description);
+    }
+    out.put<uint64_t>(account.entries.size());
+    out.putArray(account.entries.data(), account.entries.size());
+
+    out.put<uint64_t>(account.scheduledTransfers.size());
+    for (const auto& transfer : account.scheduledTransfers) {
+        out.put<int32_t>(transfer.getScheduledDay());
+        out.put<int32_t>(transfer.getNextDay());
+        out.put<int32_t>(transfer.getInterval());
+        out.put<int32_t>(transfer.getEndDay());
+        out.put<uint8_t>(transfer.getKind());
+        out.put<int64_t>(transfer.getAmount().micros());
+        out.putText(transfer.getDescription());
+        out.put<int32_t>(transfer.getExecutedCount());
+        out.put<int32_t>(transfer.getMissedCount());
+    }
+}
+
+void readAccount(Reader& in, AccountSnapshot& account) {
+    account.username = in.getText();
+    if (!PasswordHash::fromBytes(in.getText(), account.password)) in.fail();
+    account.balance = Money::fromMicros(in.get<int64_t>());
+
+    account.descriptions.resize(in.getCount(4));
+    for (auto& description : account.descriptions) {
+        description = in.getText();
+    }
+    size_t entries = in.getCount(sizeof(TransactionLedger::Entry));
+    in.getArray(account.entries, entries);
+
+    size_t transfers = in.getCount(37);
+    account.scheduledTransfers.clear();
+    account.scheduledTransfers.reserve(transfers);
+    for (size_t i = 0; i < transfers && in.ok(); i++) {
+        int scheduledDay = in.get<int32_t>();
+        int nextDay = in.get<int32_t>();
+        int interval = in.get<int32_t>();
+        int endDay = in.get<int32_t>();
+        ScheduledTransfer::Kind kind = in.get<uint8_t>() == ScheduledTransfer::WITHDRAWAL
+            ? ScheduledTransfer::WITHDRAWAL : ScheduledTransfer::DEPOSIT;
+        Money amount = Money::fromMicros(in.get<int64_t>());
+        std::string description = in.getText();
+        int executed = in.get<int32_t>();
+        int missed = in.get<int32_t>();
+
+        ScheduledTransfer transfer(scheduledDay, amount, description, kind, interval, endDay);
+        transfer.restoreProgress(nextDay, executed, missed);
+        account.scheduledTransfers.push_back(transfer);
+    }
+}
+
+// One bot's trades from `fromTrade` on and equity samples after `afterDay`, as a
+// history log chunk; false if there are none
+bool writeHistoryChunk(Writer& out, const TradingBot& bot, size_t fromTrade, int afterDay) {
+    std::vector<TradeRecords> trades = bot.getHistoryPage(fromTrade, SIZE_MAX);
+    std::vector<int32_t> days;
+    std::vector<double> equity;
+    const CompressedSeries& curve = bot.getEquityCurve();
+    if (!curve.empty() && curve.getLastDay() > afterDay) {
+        curve.forEachInRange(std::max(afterDay + 1, curve.getFirstDay()), curve.getLastDay(),
+                             [&](int day, double value) {
+            days.push_back(day);
+            equity.push_back(value);
+        });
+    }
+    if (trades.empty() && days.empty()) return false;
+
+    out.putText(bot.getAccount());
+    out.put<uint64_t>(trades.size());
+    for (const auto& trade : trades) {
+        writeTrade(out, trade);
+    }
+    out.put<uint64_t>(days.size());
+    out.putArray(days.data(), days.size());
+    out.putArray(equity.data(), equity.size());
+    return true;
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Make a rename or new file beside `path` durable
+void syncParentDirectory(const std::string& path) {
+    size_t slash = path.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : path.substr(0, slash == 0 ? 1 : slash);
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+bool readFile(const std::string& path, std::vector<char>& out) {
+    out.clear();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char buffer[1 << 16];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.insert(out.end(), buffer, buffer + count);
+    }
+    std::fclose(file);
+    return true;
+}
+
+}
+
+SimulationCheckpoint SimulationCheckpoint::capture(const StockMarket& market,
+                                                   const std::vector<const TradingBot*>& bots,
+                                                   const BankingSystem& bank) {
+    SimulationCheckpoint checkpoint = capture(market, bots);
+    checkpoint.accounts = bank.captureAccounts();
+    return checkpoint;
+}
+
+SimulationCheckpoint SimulationCheckpoint::capture(const StockMarket& market,
+                                                   const std::vector<const TradingBot*>& bots,
+                                                   bool withHistory) {
+    SimulationCheckpoint checkpoint;
+    checkpoint.market = market.getState();
+    checkpoint.bots.reserve(bots.size());
+    for (const TradingBot* bot : bots) {
+        checkpoint.bots.push_back(bot->getState(withHistory));
+    }
+    return checkpoint;
+}
+
+bool SimulationCheckpoint::restore(StockMarket& market, const std::vector<TradingBot*>& bots,
+                                   BankingSystem& bank) const {
+    // Bots first: resetting a bot that owns `market` also resets the market
+    bool restored = true;
+    for (TradingBot* bot : bots) {
+        const BotState* saved = nullptr;
+        for (const auto& state : this->bots) {
+            if (state.account == bot->getAccount()) {
+                saved = &state;
+                break;
+            }
+        }
+
+        if (saved) {
+            restored &= bot->restoreState(*saved);
+        } else {
+            bot->reset();
+        }
+    }
+
+    restored &= market.restoreState(this->market);
+    restored &= bank.restoreAccounts(accounts);
+    return restored;
+}
+
+bool SimulationCheckpoint::save(const std::string& path) const {
+    Writer out;
+    out.put<uint32_t>(kMagic);
+    out.put<uint32_t>(kVersion);
+    out.put<uint32_t>(sizeof(TransactionLedger::Entry));
+
+    writeMarket(out, market);
+    out.put<uint64_t>(bots.size());
+    for (const auto& bot : bots) {
+        writeBot(out, bot);
+    }
+    out.put<uint64_t>(accounts.size());
+    for (const auto& account : accounts) {
+        writeAccount(out, account);
+    }
+    out.put<uint64_t>(historyGeneration);
+    out.put<uint64_t>(historyBytes);
+
+    // Write beside the target, sync and rename, so a failed save or a crash
+    // leaves the old file intact
+    std::string temporary = path + ".tmp";
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool written = writeAll(fd, out.data.data(), out.data.size()) && ::fsync(fd) == 0;
+    written &= ::close(fd) == 0;
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    syncParentDirectory(path);
+    return true;
+}
+
+bool SimulationCheckpoint::load(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)info.st_size;
+    void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) return false;
+
+    Reader in(static_cast<const char*>(mapped), size);
+    SimulationCheckpoint loaded;
+    bool valid = in.get<uint32_t>() == kMagic && in.get<uint32_t>() == kVersion &&
+                 in.get<uint32_t>() == sizeof(TransactionLedger::Entry);
+
+    if (valid) {
+        readMarket(in, loaded.market);
+
+        loaded.bots.resize(in.getCount(8));
+        for (auto& bot : loaded.bots) {
+            readBot(in, bot);
+        }
+
+        loaded.accounts.resize(in.getCount(8));
+        for (auto& account : loaded.accounts) {
+            readAccount(in, account);
+        }
+        loaded.historyGeneration = in.get<uint64_t>();
+        loaded.historyBytes = in.get<uint64_t>();
+        valid = in.ok() && in.atEnd();
+    }
+
+    ::munmap(mapped, size);
+    if (!valid) return false;
+
+    *this = std::move(loaded);
+    return true;
+}
+
+// --- Rolling checkpoint ---
+
+RollingCheckpoint::RollingCheckpoint(const std::string& path)
+    : path_(path), logFd_(-1), generation_(0), logBytes_(0), restart_(true) {}
+
+RollingCheckpoint::~RollingCheckpoint() {
+    if (logFd_ >= 0) ::close(logFd_);
+}
+
+std::string RollingCheckpoint::logPath(uint64_t generation) const {
+    return path_ + "." + std::to_string(generation) + ".log";
+}
+
+// Begin an empty log of `generation`; the next save writes all history to it
+bool RollingCheckpoint::startLog(uint64_t generation) {
+    int fd = ::open(logPath(generation).c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    Writer head;
+    head.put<uint32_t>(kLogMagic);
+    head.put<uint32_t>(kLogVersion);
+    head.put<uint64_t>(generation);
+    if (!writeAll(fd, head.data.data(), head.data.size())) {
+        ::close(fd);
+        return false;
+    }
+
+    if (logFd_ >= 0) {
+        ::close(logFd_);
+        // the saved checkpoint still points at the old log until the next one replaces it
+        if (staleLog_.empty()) staleLog_ = logPath(generation_);
+    }
+    logFd_ = fd;
+    generation_ = generation;
+    logBytes_ = kLogHeaderSize;
+    saved_.clear();
+    return true;
+}
+
+bool RollingCheckpoint::save(const StockMarket& market, const std::vector<const TradingBot*>& bots) {
+    // History that shrank was replaced; appending to it would repeat or mix runs
+    for (const TradingBot* bot : bots) {
+        auto it = saved_.find(bot->getAccount());
+        if (it != saved_.end() && ((size_t)bot->getTradeCount() < it->second.trades ||
+                                   bot->getEquityCurve().size() < it->second.samples)) {
+            restart_ = true;
+        }
+    }
+    if (logFd_ < 0 || restart_) {
+        if (!startLog(generation_ + 1)) return false;
+        restart_ = false;
+    }
+
+    // What is new since the last save, written after what the checkpoint covers
+    // (a save that failed may have left bytes past it)
+    Writer out;
+    std::unordered_map<std::string, Position> positions = saved_;
+    for (const TradingBot* bot : bots) {
+        auto it = saved_.find(bot->getAccount());
+        Position from = it != saved_.end() ? it->second : Position{0, 0, INT_MIN};
+        if (writeHistoryChunk(out, *bot, from.trades, from.lastDay)) {
+            const CompressedSeries& curve = bot->getEquityCurve();
+            positions[bot->getAccount()] = {(size_t)bot->getTradeCount(), curve.size(),
+                                            curve.empty() ? INT_MIN : curve.getLastDay()};
+        }
+    }
+    if (::lseek(logFd_, (off_t)logBytes_, SEEK_SET) < 0 ||
+        !writeAll(logFd_, out.data.data(), out.data.size()) || ::fsync(logFd_) != 0) {
+        return false;
+    }
+
+    SimulationCheckpoint checkpoint = SimulationCheckpoint::capture(market, bots, false);
+    checkpoint.historyGeneration = generation_;
+    checkpoint.historyBytes = logBytes_ + out.data.size();
+    if (!checkpoint.save(path_)) return false;
+
+    logBytes_ = checkpoint.historyBytes;
+    saved_ = std::move(positions);
+    if (!staleLog_.empty()) {
+        std::remove(staleLog_.c_str());
+        staleLog_.clear();
+    }
+    return true;
+}
+
+bool RollingCheckpoint::load(SimulationCheckpoint& checkpoint) {
+    SimulationCheckpoint loaded;
+    if (!loaded.load(path_)) return false;
+    if (loaded.historyGeneration == 0) {
+        // a plain checkpoint; the next save starts a log
+        checkpoint = std::move(loaded);
+        restart_ = true;
+        return true;
+    }
+
+    std::vector<char> file;
+    std::string path = logPath(loaded.historyGeneration);
+    if (!readFile(path, file) || file.size() < loaded.historyBytes || loaded.historyBytes < kLogHeaderSize) {
+        return false;
+    }
+
+    Reader in(file.data(), loaded.historyBytes);
+    bool valid = in.get<uint32_t>() == kLogMagic && in.get<uint32_t>() == kLogVersion &&
+                 in.get<uint64_t>() == loaded.historyGeneration;
+
+    // Put each chunk back on its bot, then rebuild the equity curves
+    std::unordered_map<std::string, size_t> botIndex;
+    for (size_t i = 0; i < loaded.bots.size(); i++) {
+        botIndex[loaded.bots[i].account] = i;
+    }
+    std::vector<std::vector<int32_t>> days(loaded.bots.size());
+    std::vector<std::vector<double>> equity(loaded.bots.size());
+
+    std::vector<int32_t> chunkDays;
+    std::vector<double> chunkEquity;
+    while (valid && in.ok() && !in.atEnd()) {
+        std::string account = in.getText();
+        auto it = botIndex.find(account);
+        BotState* bot = it != botIndex.end() ? &loaded.bots[it->second] : nullptr;
+
+        size_t trades = in.getCount(kMinimumTradeSize);
+        for (size_t i = 0; i < trades && in.ok(); i++) {
+            TradeRecords trade;
+            readTrade(in, trade);
+            if (bot) bot->history.push_back(std::move(trade));
+        }
+
+        size_t samples = in.getCount(sizeof(int32_t) + sizeof(double));
+        in.getArray(chunkDays, samples);
+        in.getArray(chunkEquity, samples);
+        if (bot && in.ok()) {
+            days[it->second].insert(days[it->second].end(), chunkDays.begin(), chunkDays.end());
+            equity[it->second].insert(equity[it->second].end(), chunkEquity.begin(), chunkEquity.end());
+        }
+    }
+    if (!valid || !in.ok()) return false;
+
+    for (size_t i = 0; i < loaded.bots.size(); i++) {
+        CompressedSeries curve;
+        for (size_t k = 0; k < days[i].size(); k++) {
+            curve.append(days[i][k], equity[i][k]);
+        }
+        loaded.bots[i].performance = PerformanceTracker(loaded.bots[i].performance.getTotals(), curve);
+    }
+
+    // Carry on appending where the checkpoint ends
+    int fd = ::open(path.c_str(), O_WRONLY);
+    if (fd < 0) return false;
+    if (logFd_ >= 0) ::close(logFd_);
+    logFd_ = fd;
+    generation_ = loaded.historyGeneration;
+    logBytes_ = loaded.historyBytes;
+    restart_ = false;
+    staleLog_.clear();
+    std::remove(logPath(generation_ + 1).c_str());  // left by a restart that never got its checkpoint
+
+    saved_.clear();
+    for (const auto& bot : loaded.bots) {
+        const CompressedSeries& curve = bot.performance.getEquityCurve();
+        saved_[bot.account] = {bot.history.size(), curve.size(), curve.empty() ? INT_MIN : curve.getLastDay()};
+    }
+
+    checkpoint = std::move(loaded);
+    return true;
+}
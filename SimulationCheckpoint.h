@@ -0,0 +1,98 @@
+// SimulationCheckpoint.h
+// Whole-simulation checkpoint: the market (universe, prices, day and random
+// stream), the trading bots and every bank account, saved to one binary file.
+// Files are read back through mmap and decoded in a single pass; price columns
+// and ledger entries are stored in their in-memory layout and copied in bulk,
+// so a file is only meant to be read by a build for the same platform.
+// Load a checkpoint once and restore() it as often as needed to branch many
+// what-if runs from the same warm state.
+// RollingCheckpoint keeps one checkpoint up to date across many saves, writing
+// the ever-growing trade history and equity curves to a log beside it.
+
+#ifndef SIMULATIONCHECKPOINT_H
+#define SIMULATIONCHECKPOINT_H
+
+#include "TradingBot.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct SimulationCheckpoint {
+    MarketState market;
+    std::vector<BotState> bots;
+    std::vector<AccountSnapshot> accounts;
+
+    // Non-zero for a RollingCheckpoint save: the bots' trade history and equity
+    // samples are not in `bots` but in history log `historyGeneration`, whose
+    // first `historyBytes` bytes belong to this checkpoint
+    uint64_t historyGeneration = 0;
+    uint64_t historyBytes = 0;
+
+    // Capture the current state. The bots must trade on `market`.
+    static SimulationCheckpoint capture(const StockMarket& market, const std::vector<const TradingBot*>& bots,
+                                        const BankingSystem& bank);
+    // Same, without the accounts, for when the bank keeps its own journal.
+    // Without history the bots' trade history and equity curves are left out.
+    static SimulationCheckpoint capture(const StockMarket& market, const std::vector<const TradingBot*>& bots,
+                                        bool withHistory = true);
+
+    // Put the market, bots and accounts back. Each bot gets the saved state for
+    // its account; bots without one are reset. Accounts missing from the
+    // checkpoint are left alone. Nothing may be trading meanwhile.
+    bool restore(StockMarket& market, const std::vector<TradingBot*>& bots, BankingSystem& bank) const;
+
+    // Binary file I/O. Returns false on I/O errors or a damaged/foreign file.
+    // save() makes the file durable before it replaces the old one.
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// A checkpoint saved again and again (the GUI saves after every trading day)
+// without each save costing more than the last. The checkpoint file holds what
+// stays small: market, bot settings, portfolios, rankings and performance
+// totals, rewritten whole. Trade history and equity samples only grow, so they
+// are appended to a history log beside it (path.<generation>.log) and a save
+// writes only what was added since the previous one. The log is synced before
+// the checkpoint that covers it, and records past the covered length (a save
+// that didn't finish) are dropped on load.
+class RollingCheckpoint {
+public:
+    explicit RollingCheckpoint(const std::string& path);
+    ~RollingCheckpoint();
+
+    RollingCheckpoint(const RollingCheckpoint&) = delete;
+    RollingCheckpoint& operator=(const RollingCheckpoint&) = delete;
+
+    // Read the last save, history included; later saves carry on from it.
+    // Also reads a plain SimulationCheckpoint file.
+    bool load(SimulationCheckpoint& checkpoint);
+
+    // Save the market and bots (no accounts). The bots must trade on `market`.
+    bool save(const StockMarket& market, const std::vector<const TradingBot*>& bots);
+
+    // The bots' history was replaced (reset, another checkpoint restored), so
+    // the next save writes it all to a new log instead of appending
+    void restartHistory() { restart_ = true; }
+
+private:
+    // What of one bot's history the log already holds
+    struct Position {
+        size_t trades;
+        size_t samples;
+        int lastDay;     // day of the last equity sample written
+    };
+
+    std::string logPath(uint64_t generation) const;
+    bool startLog(uint64_t generation);
+
+    std::string path_;
+    int logFd_;
+    uint64_t generation_;
+    uint64_t logBytes_;                                  // covered by the saved checkpoint
+    std::unordered_map<std::string, Position> saved_;    // by account
+    std::string staleLog_;   // previous generation, removed once a checkpoint no longer needs it
+    bool restart_;
+};
+
+#endif // SIMULATIONCHECKPOINT_H
@@ -0,0 +1,37 @@
+# Core simulation engine: banking, trading bot and facade.
+# Plain C++17, no Qt modules needed. Shared by the GUI, the engine library and the CLI.
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/BankingTradingFacade.cpp \
+    $$PWD/MonteCarloEngine.cpp \
+    $$PWD/ParameterSweep.cpp \
+    $$PWD/Tournament.cpp \
+    $$PWD/SimulationRunner.cpp \
+    $$PWD/SimulationCheckpoint.cpp \
+    $$PWD/WriteAheadLog.cpp \
+    $$PWD/PasswordHash.cpp \
+    $$PWD/ScoringKernel.cpp \
+    $$PWD/TimeSeriesStore.cpp
+
+HEADERS += \
+    $$PWD/Money.h \
+    $$PWD/PasswordHash.h \
+    $$PWD/WriteAheadLog.h \
+    $$PWD/BankingSystem.h \
+    $$PWD/StockAbstractFactory.h \
+    $$PWD/StockMarket.h \
+    $$PWD/ScoringKernel.h \
+    $$PWD/TimeSeriesStore.h \
+    $$PWD/PerformanceTracker.h \
+    $$PWD/TradingBot.h \
+    $$PWD/BotScheduler.h \
+    $$PWD/BankingTradingFacade.h \
+    $$PWD/WorkStealingPool.h \
+    $$PWD/MonteCarloEngine.h \
+    $$PWD/PricePath.h \
+    $$PWD/ParameterSweep.h \
+    $$PWD/Tournament.h \
+    $$PWD/SimulationRunner.h \
+    $$PWD/SimulationCheckpoint.h
@@ -0,0 +1,335 @@
+// SimulationRunner.cpp
+// Implementation of the headless batch simulation driver
+
+#include "SimulationRunner.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+
+namespace {
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t\r\n");
+    return text.substr(start, end - start + 1);
+}
+
+bool parseInt(const std::string& text, long& value) {
+    char* end = nullptr;
+    value = std::strtol(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0';
+}
+
+bool parseDouble(const std::string& text, double& value) {
+    char* end = nullptr;
+    value = std::strtod(text.c_str(), &end);
+    return !text.empty() && *end == '\0';
+}
+
+}
+
+// --- Configuration ---
+
+bool SimulationRunner::applySetting(SimulationConfig& config, const std::string& setting, std::string& error) {
+    size_t eq = setting.find('=');
+    if (eq == std::string::npos) {
+        error = "Expected key=value, got '" + setting + "'";
+        return false;
+    }
+
+    std::string key = trim(setting.substr(0, eq));
+    std::string value = trim(setting.substr(eq + 1));
+    long number = 0;
+
+    if (key == "mode") {
+        if (value != "accounts" && value != "montecarlo" && value != "sweep" && value != "tournament") {
+            error = "mode must be accounts, montecarlo, sweep or tournament";
+            return false;
+        }
+        config.mode = value;
+    } else if (key == "universe") {
+        if (value != "default" && !parseInt(value, number)) {
+            std::vector<StockListing> listings;  // a universe file; check it reads
+            if (!StockMarket::readUniverseFile(value, listings, error)) return false;
+        } else if (value != "default" && number <= 0) {
+            error = "universe must be 'default', a positive ticker count or a file";
+            return false;
+        }
+        config.universe = value;
+    } else if (key == "strategy") {
+        if (value != "auto" && value != "aggressive" && value != "conservative") {
+            error = "strategy must be auto, aggressive or conservative";
+            return false;
+        }
+        config.strategy = value;
+    } else if (key == "seed") {
+        if (!parseInt(value, number) || number < 0) {
+            error = "seed must be a non-negative integer";
+            return false;
+        }
+        config.seed = (unsigned)number;
+    } else if (key == "days") {
+        if (!parseInt(value, number) || number < 0) {
+            error = "days must be a non-negative integer";
+            return false;
+        }
+        config.days = (int)number;
+    } else if (key == "accounts") {
+        if (!parseInt(value, number) || number <= 0) {
+            error = "accounts must be a positive integer";
+            return false;
+        }
+        config.accounts = (int)number;
+    } else if (key == "simulations") {
+        if (!parseInt(value, number) || number <= 0) {
+            error = "simulations must be a positive integer";
+            return false;
+        }
+        config.simulations = (int)number;
+    } else if (key == "threads") {
+        if (!parseInt(value, number) || number < 0) {
+            error = "threads must be a non-negative integer";
+            return false;
+        }
+        config.threads = (unsigned)number;
+    } else if (key == "take_profit") {
+        if (!ParameterSweep::parseValues(value, config.sweepGrid.takeProfits)) {
+            error = "take_profit must be start:stop:step or a comma list";
+            return false;
+        }
+    } else if (key == "stop_loss") {
+        if (!ParameterSweep::parseValues(value, config.sweepGrid.stopLosses)) {
+            error = "stop_loss must be start:stop:step or a comma list";
+            return false;
+        }
+    } else if (key == "max_holdings") {
+        std::vector<double> holdings;
+        if (!ParameterSweep::parseValues(value, holdings)) {
+            error = "max_holdings must be start:stop:step or a comma list";
+            return false;
+        }
+        config.sweepGrid.maxHoldings.clear();
+        for (double h : holdings) {
+            config.sweepGrid.maxHoldings.push_back((int)(h + 0.5));
+        }
+    } else if (key == "strategies") {
+        config.sweepGrid.strategies.clear();
+        size_t begin = 0;
+        while (begin <= value.size()) {
+            size_t comma = value.find(',', begin);
+            if (comma == std::string::npos) comma = value.size();
+            std::string name = trim(value.substr(begin, comma - begin));
+            if (name != "auto" && name != "aggressive" && name != "conservative") {
+                error = "strategies must be a comma list of auto, aggressive, conservative";
+                return false;
+            }
+            config.sweepGrid.strategies.push_back(name);
+            begin = comma + 1;
+        }
+    } else if (key == "entries") {
+        config.entries.clear();
+        size_t begin = 0;
+        while (begin <= value.size()) {
+            size_t comma = value.find(',', begin);
+            if (comma == std::string::npos) comma = value.size();
+            TournamentEntry entry;
+            if (!Tournament::parseEntry(trim(value.substr(begin, comma - begin)), entry)) {
+                error = "entries must be a comma list of strategy or strategy:take_profit:stop_loss:max_holdings";
+                return false;
+            }
+            config.entries.push_back(entry);
+            begin = comma + 1;
+        }
+    } else if (key == "paths") {
+        if (!parseInt(value, number) || number <= 0) {
+            error = "paths must be a positive integer";
+            return false;
+        }
+        config.paths = (int)number;
+    } else if (key == "top") {
+        if (!parseInt(value, number) || number < 0) {
+            error = "top must be a non-negative integer";
+            return false;
+        }
+        config.top = (size_t)number;
+    } else if (key == "balance") {
+        double balance = 0.0;
+        if (!parseDouble(value, balance) || balance <= 0) {
+            error = "balance must be a positive number";
+            return false;
+        }
+        config.initialBalance = Money::fromDouble(balance);
+    } else if (key == "output") {
+        config.output = value;
+    } else {
+        error = "Unknown setting '" + key + "'";
+        return false;
+    }
+
+    return true;
+}
+
+bool SimulationRunner::loadConfigFile(SimulationConfig& config, const std::string& path, std::string& error) {
+    std::ifstream in(path);
+    if (!in) {
+        error = "Cannot open config file " + path;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t comment = line.find('#');
+        if (comment != std::string::npos) line.erase(comment);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        if (!applySetting(config, line, error)) return false;
+    }
+    return true;
+}
+
+// --- Universe ---
+
+std::vector<StockListing> SimulationRunner::buildUniverse(const SimulationConfig& config) {
+    if (config.universe == "default") {
+        return {};  // keep the bot's built-in tickers
+    }
+
+    std::vector<StockListing> listings;
+    long count = 0;
+    if (!parseInt(config.universe, count)) {
+        std::string error;
+        StockMarket::readUniverseFile(config.universe, listings, error);
+        return listings;  // checked by applySetting; empty keeps the built-in tickers
+    }
+
+    listings.reserve(count);
+
+    // Synthetic tickers with opening prices spread between $5 and $505
+    RandomSource rng(config.seed);
+    char symbol[32];
+    for (long i = 0; i < count; i++) {
+        std::snprintf(symbol, sizeof(symbol), "SYM%06ld", i);
+        StockListing listing;
+        listing.ticker_symbol = symbol;
+        listing.name = std::string("Synthetic ") + symbol;
+        listing.openingPrice = 5.0 + (rng.nextInt(50000)) / 100.0;
+        listings.push_back(listing);
+    }
+    return listings;
+}
+
+// --- Running ---
+
+std::vector<SimulationResult> SimulationRunner::run(const SimulationConfig& config) {
+    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
+    std::vector<SimulationResult> results;
+    results.reserve(config.accounts);
+
+    // nobody holds anything after a reset, so any universe can be loaded
+    facade.resetSimulation(config.initialBalance);
+    std::vector<StockListing> universe = buildUniverse(config);
+    std::string error;
+    if (!universe.empty()) {
+        facade.loadUniverse(universe, error);
+    }
+
+    facade.setSeed(config.seed);
+
+    bool autoSwitch = (config.strategy == "auto");
+    std::string strategyName = (config.strategy == "aggressive") ? "Aggressive" : "Conservative";
+
+    // Set every account up once; their bots then trade the same market days
+    // together, through the facade's bot scheduler
+    std::vector<std::string> accounts;
+    accounts.reserve(config.accounts);
+    for (int i = 0; i < config.accounts; i++) {
+        std::string account = "sim" + std::to_string(i + 1);
+        facade.registerUser(account, "", config.initialBalance);
+        facade.login(account, "");
+        facade.setStrategy(strategyName, autoSwitch);
+        facade.startBot();
+        accounts.push_back(account);
+    }
+
+    BankingTradingFacade::FastForwardSummary run = facade.advanceDays(config.days);
+
+    for (const auto& account : accounts) {
+        facade.login(account, "");
+
+        SimulationResult result;
+        result.account = account;
+        result.seed = config.seed;
+        result.strategy = config.strategy;
+        result.summary.startDay = run.startDay;
+        result.summary.endDay = run.endDay;
+        result.summary.depositsExecuted = 0;  // the runner schedules no transfers
+        result.summary.tradesExecuted = (int)facade.getTradeCount();
+        result.summary.startingBalance = config.initialBalance;
+        result.summary.endingBalance = facade.getBalance();
+        result.summary.totalProfit = facade.getPerformance().totalProfit;
+        results.push_back(result);
+    }
+    facade.logout();
+
+    return results;
+}
+
+MonteCarloReport SimulationRunner::runMonteCarlo(const SimulationConfig& config) {
+    MonteCarloConfig mc;
+    mc.simulations = config.simulations;
+    mc.days = config.days;
+    mc.seed = config.seed;
+    mc.strategy = config.strategy;
+    mc.initialBalance = config.initialBalance;
+    mc.universe = buildUniverse(config);
+    mc.threads = config.threads;
+
+    MonteCarloEngine engine;
+    return engine.run(mc);
+}
+
+std::vector<SweepResult> SimulationRunner::runSweep(const SimulationConfig& config) {
+    SweepConfig sweep;
+    sweep.grid = config.sweepGrid;
+    sweep.days = config.days;
+    sweep.paths = config.paths;
+    sweep.seed = config.seed;
+    sweep.initialBalance = config.initialBalance;
+    sweep.universe = buildUniverse(config);
+    sweep.threads = config.threads;
+
+    ParameterSweep runner;
+    return runner.run(sweep);
+}
+
+std::vector<TournamentStanding> SimulationRunner::runTournament(const SimulationConfig& config) {
+    TournamentConfig tournament;
+    tournament.entries = config.entries;
+    tournament.days = config.days;
+    tournament.seed = config.seed;
+    tournament.initialBalance = config.initialBalance;
+    tournament.universe = buildUniverse(config);
+    tournament.threads = config.threads;
+
+    Tournament runner;
+    return runner.run(tournament);
+}
+
+void SimulationRunner::writeCsv(std::ostream& out, const std::vector<SimulationResult>& results) {
+    out << "account,seed,strategy,start_day,end_day,starting_balance,ending_balance,"
+           "total_profit,trades,deposits\n";
+
+    char line[512];
+    for (const auto& r : results) {
+        std::snprintf(line, sizeof(line), "%s,%u,%s,%d,%d,%.2f,%.2f,%.2f,%d,%d\n",
+                      r.account.c_str(), r.seed, r.strategy.c_str(),
+                      r.summary.startDay, r.summary.endDay,
+                      r.summary.startingBalance.toDouble(), r.summary.endingBalance.toDouble(),
+                      r.summary.totalProfit.toDouble(), r.summary.tradesExecuted,
+                      r.summary.depositsExecuted);
+        out << line;
+    }
+}
@@ -0,0 +1,72 @@
+// SimulationRunner.h
+// Headless driver for batch simulations. Runs the same backend the GUI uses
+// (through BankingTradingFacade) without any Qt dependency.
+
+#ifndef SIMULATIONRUNNER_H
+#define SIMULATIONRUNNER_H
+
+#include "BankingTradingFacade.h"
+#include "MonteCarloEngine.h"
+#include "ParameterSweep.h"
+#include "Tournament.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Settings for one batch of simulations
+struct SimulationConfig {
+    std::string mode = "accounts";     // "accounts", "montecarlo", "sweep" or "tournament"
+    std::string universe = "default";  // "default", a number of synthetic tickers or a universe file
+    std::string strategy = "auto";     // "auto", "aggressive" or "conservative"
+    unsigned seed = 42;
+    int days = 252;
+    int accounts = 1;
+    Money initialBalance = Money::units(10000);
+    int simulations = 1000;            // montecarlo mode only
+    unsigned threads = 0;              // montecarlo/sweep/tournament modes, 0 = all cores
+    SweepGrid sweepGrid;               // sweep mode only
+    int paths = 4;                     // sweep mode only, price paths per parameter set
+    std::vector<TournamentEntry> entries = {{"aggressive", "aggressive"},
+                                            {"conservative", "conservative"},
+                                            {"auto", "auto"}};  // tournament mode only
+    size_t top = 0;                    // sweep/tournament modes, rows to write (0 = all)
+    std::string output;                // results file, empty for stdout
+};
+
+// Outcome of one simulated account
+struct SimulationResult {
+    std::string account;
+    unsigned seed;
+    std::string strategy;
+    BankingTradingFacade::FastForwardSummary summary;
+};
+
+class SimulationRunner {
+public:
+    // Apply a "key=value" setting. Returns false (and fills error) for bad input.
+    static bool applySetting(SimulationConfig& config, const std::string& setting, std::string& error);
+
+    // Read "key=value" lines from a config file ('#' starts a comment)
+    static bool loadConfigFile(SimulationConfig& config, const std::string& path, std::string& error);
+
+    // Build the ticker universe named by the config
+    static std::vector<StockListing> buildUniverse(const SimulationConfig& config);
+
+    // Run config.accounts accounts' bots side by side on one shared market,
+    // from a fresh reset
+    std::vector<SimulationResult> run(const SimulationConfig& config);
+
+    // Run config.simulations independent paths in parallel (montecarlo mode)
+    MonteCarloReport runMonteCarlo(const SimulationConfig& config);
+
+    // Evaluate the parameter grid on shared price paths (sweep mode)
+    std::vector<SweepResult> runSweep(const SimulationConfig& config);
+
+    // Play config.entries against each other on one market (tournament mode)
+    std::vector<TournamentStanding> runTournament(const SimulationConfig& config);
+
+    // Write results as CSV with a header row
+    static void writeCsv(std::ostream& out, const std::vector<SimulationResult>& results);
+};
+
+#endif // SIMULATIONRUNNER_H
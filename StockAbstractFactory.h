@@ -1,8 +1,49 @@
 #ifndef STOCKABSTRACTFACTORY_H
 #define STOCKABSTRACTFACTORY_H
 #include <iostream>
+#include <cstdint>
+#include <cstdlib>
 using namespace std;
 
+/*
+*  Small, fast random number source (xorshift64*).
+*  Each simulation owns one, so runs are reproducible from a seed and
+*  independent runs can go in parallel without sharing rand()'s global state.
+*/
+class RandomSource {
+private:
+    uint64_t state;
+
+public:
+    explicit RandomSource(uint64_t seed = 1) {
+        setSeed(seed);
+    }
+
+    // splitmix64 scramble so neighbouring seeds give unrelated streams
+    void setSeed(uint64_t seed) {
+        uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        state = z ^ (z >> 31);
+        if (state == 0) state = 0x9E3779B97F4A7C15ULL;
+    }
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+
+    // uniform integer in [0, bound)
+    int nextInt(int bound) {
+        return (int)(((next() >> 32) * (uint64_t)bound) >> 32);
+    }
+
+    uint64_t getState() const { return state; }
+    void setState(uint64_t s) { state = s; }
+};
+
 class StockAbstractFactory {
 public:
     virtual ~StockAbstractFactory() {}
@@ -44,6 +85,13 @@ public:
         double percentChange = drift + (randomMove * volatility);
         return price * (1.0 + percentChange);
     }
+
+    // same move, drawn from a caller-owned random source
+    double generate(double price, RandomSource& rng) {
+        double randomMove = (rng.nextInt(2001) - 1000) / 1000.0; // -1 to +1
+        double percentChange = drift + (randomMove * volatility);
+        return price * (1.0 + percentChange);
+    }
 };
 
 // Use function in main
@@ -0,0 +1,472 @@
+#ifndef STOCKMARKET_H
+#define STOCKMARKET_H
+
+#include "StockAbstractFactory.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace std;
+
+// Descriptive data of one stock. Kept apart from the prices, which the
+// per-day loops scan for every stock (see StockTable).
+struct StockInfo {
+    Stock *stock;               // created on first use, see StockMarket::getStock
+    string ticker_symbol;
+    string name;
+    double openingPrice;
+};
+
+
+// One stock as read through a StockTable: its description by reference and
+// its two prices by value
+struct StockFields {
+    const string& ticker_symbol;
+    const string& name;
+    double cur;
+    double prev;
+    double openingPrice;
+
+
+    // checks if stock price went up or down during that day
+    bool priceDown() const {
+        return cur < prev;
+    }
+
+    bool priceUp() const {
+        return cur > prev;
+    }
+
+
+    //get change in percentage of current price from the day before
+    double getPercentChange() const {
+        if(prev == 0) {
+            return 0.0;
+        }
+
+        return ((cur - prev) / prev) * 100.0;
+    }
+
+};
+
+
+
+/*
+    Read-only view of a market's stocks, in universe order.
+
+    Prices live in two contiguous columns (today's and yesterday's), so a scan
+    over the whole market reads 16 bytes per stock; curPrices()/prevPrices()
+    give the columns to loops that only need prices. Names and the rest are
+    reached through info(i), or together with the prices as a StockFields via
+    operator[] and iteration. A view stays valid until the universe changes.
+*/
+class StockTable {
+private:
+    const double* cur;
+    const double* prev;
+    const StockInfo* infos;
+    int count;
+
+public:
+    class iterator {
+    private:
+        const StockTable* table;
+        int index;
+
+    public:
+        iterator(const StockTable* t, int i) : table(t), index(i) {}
+        StockFields operator*() const { return (*table)[index]; }
+        iterator& operator++() { index++; return *this; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    StockTable() : cur(nullptr), prev(nullptr), infos(nullptr), count(0) {}
+    StockTable(const double* cur, const double* prev, const StockInfo* infos, int count)
+        : cur(cur), prev(prev), infos(infos), count(count) {}
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const double* curPrices() const { return cur; }
+    const double* prevPrices() const { return prev; }
+    const StockInfo& info(int i) const { return infos[i]; }
+
+    StockFields operator[](int i) const {
+        return {infos[i].ticker_symbol, infos[i].name, cur[i], prev[i], infos[i].openingPrice};
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, count); }
+};
+
+
+// One entry of a ticker universe (symbol, display name and opening price)
+struct StockListing {
+    string ticker_symbol;
+    string name;
+    double openingPrice;
+};
+
+
+// Everything needed to put a market back where it was (see StockMarket::getState)
+struct MarketState {
+    int currentDay;
+    uint64_t rngState;
+    vector<StockListing> listings;  // universe, in order
+    vector<double> cur;             // one price per listing
+    vector<double> prev;
+};
+
+
+/*
+    The simulated market: every tradable stock, its price generator and the day counter.
+
+    A market can be owned by a single bot (standalone simulations) or shared by many
+    per-account bots, in which case it is advanced once per day by whoever schedules
+    the bots, and read by all of them during their trading cycles.
+
+    Prices are stored as columns and descriptions separately (see StockTable).
+    Loading a universe only copies listings: symbols are interned into an index for
+    O(1) price lookups, Stock objects are made when first asked for, and the factory's
+    generators are stateless (each move draws from the market's random source), so
+    one generator is made on the first price move and shared by every stock.
+*/
+class StockMarket {
+private:
+    vector<double> curPrices;                 // hot: one price per stock, universe order
+    vector<double> prevPrices;
+    vector<StockInfo> stocks;                 // cold: descriptions, same order
+    unordered_map<string, int> symbolIndex;   // ticker symbol -> index in stocks
+    StockAbstractFactory* factory;
+    StockPriceGenerator* generator;           // shared, created on first use
+    RandomSource rng;
+    int currentDay;
+    uint64_t universeId;                      // changes whenever the universe is replaced
+
+    void addStock(const string& symbol, const string& name, double price) {
+
+        StockInfo s;
+        s.stock = nullptr;
+        s.ticker_symbol = symbol;
+        s.name = name;
+        s.openingPrice = price;
+        symbolIndex.emplace(s.ticker_symbol, (int)stocks.size());
+        stocks.push_back(std::move(s));
+        curPrices.push_back(price);
+        prevPrices.push_back(price);
+    }
+
+    void clearStocks() {
+        for (int i = 0; i < stocks.size(); i++) {
+            delete stocks[i].stock;
+        }
+        stocks.clear();
+        curPrices.clear();
+        prevPrices.clear();
+        symbolIndex.clear();
+    }
+
+    // unique across markets, so caches keyed by it can't mix two markets up
+    static uint64_t nextUniverseId() {
+        static atomic<uint64_t> next(1);
+        return next.fetch_add(1, memory_order_relaxed);
+    }
+
+    StockPriceGenerator* priceGenerator() {
+        if (!generator) {
+            generator = factory->createPriceGenerator();
+        }
+        return generator;
+    }
+
+public:
+    explicit StockMarket(uint64_t seed = 1)
+        : factory(new SimpleStockFactory()), generator(nullptr), rng(seed), currentDay(1), universeId(0) {
+        loadUniverse(defaultUniverse());
+    }
+
+    ~StockMarket() {
+        clearStocks();
+        delete generator;
+        delete factory;
+    }
+
+    StockMarket(const StockMarket&) = delete;
+    StockMarket& operator=(const StockMarket&) = delete;
+
+    // The built-in 14 ticker market
+    static vector<StockListing> defaultUniverse() {
+        return {
+            {"GOOG", "Alphabet", 320.12},
+            {"AMZN", "Amazon", 233.22},
+            {"NVDA", "Nvidia", 176.98},
+            {"MSFT", "Microsoft", 491.92},
+            {"META", "Meta Platforms", 647.95},
+            {"GME", "GameStop Corp", 22.53},
+            {"TSLA", "Tesla Inc", 430.17},
+            {"GM", "General Motors", 45.00},
+            {"F", "Ford Motor Co", 13.28},
+            {"WMT", "Walmart Inc", 110.51},
+            {"YELP", "Yelp Inc", 28.91},
+            {"SONY", "Sony Group Corp", 29.35},
+            {"MCD", "McDonalds Corp", 311.82},
+            {"CSUSM", "San Marcos", 100.00},
+        };
+    }
+
+    // Replace the tradable stocks with a new universe, every stock at its opening price.
+    // A symbol listed twice keeps its first entry.
+    void loadUniverse(const vector<StockListing>& listings) {
+        clearStocks();
+        universeId = nextUniverseId();
+        stocks.reserve(listings.size());
+        curPrices.reserve(listings.size());
+        prevPrices.reserve(listings.size());
+        symbolIndex.reserve(listings.size());
+
+        for (const auto& listing : listings) {
+            if (symbolIndex.count(listing.ticker_symbol)) continue;
+            addStock(listing.ticker_symbol, listing.name, listing.openingPrice);
+        }
+    }
+
+    // Swap in a new universe mid-run. Stocks that are still listed keep their
+    // current and previous prices, so positions in them keep their value; new
+    // ones start at their opening price. The day and random stream carry on.
+    void reloadUniverse(const vector<StockListing>& listings) {
+        vector<StockInfo> old;
+        old.swap(stocks);
+        vector<double> oldCur, oldPrev;
+        oldCur.swap(curPrices);
+        oldPrev.swap(prevPrices);
+        unordered_map<string, int> oldIndex;
+        oldIndex.swap(symbolIndex);
+
+        loadUniverse(listings);
+
+        for (int i = 0; i < stocks.size(); i++) {
+            auto it = oldIndex.find(stocks[i].ticker_symbol);
+            if (it != oldIndex.end()) {
+                curPrices[i] = oldCur[it->second];
+                prevPrices[i] = oldPrev[it->second];
+            }
+        }
+        for (int i = 0; i < old.size(); i++) {
+            delete old[i].stock;
+        }
+    }
+
+    // Read a universe file: one "SYMBOL,Name,OpeningPrice" line per ticker.
+    // Blank lines and '#' comments are skipped, and so is a first line whose
+    // price column isn't a number (a header). Names may contain commas.
+    // Returns false (and fills error) for unreadable files or bad lines.
+    static bool readUniverseFile(const string& path, vector<StockListing>& listings, string& error) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) {
+            error = "Cannot open universe file " + path;
+            return false;
+        }
+
+        // one read for the whole file, then parse in place
+        string text;
+        char buffer[1 << 16];
+        size_t count;
+        while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            text.append(buffer, count);
+        }
+        fclose(file);
+
+        listings.clear();
+        listings.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+        unordered_set<string_view> seen;   // views into text
+        seen.reserve(listings.capacity());
+
+        // [begin, end) of a field, without surrounding whitespace
+        auto trim = [&text](size_t& begin, size_t& end) {
+            while (begin < end && isspace((unsigned char)text[begin])) begin++;
+            while (end > begin && isspace((unsigned char)text[end - 1])) end--;
+        };
+
+        bool firstLine = true;
+        int lineNumber = 0;
+        for (size_t start = 0; start < text.size(); ) {
+            size_t end = text.find('\n', start);
+            if (end == string::npos) end = text.size();
+            size_t lineStart = start, lineEnd = end;
+            start = end + 1;
+            lineNumber++;
+
+            trim(lineStart, lineEnd);
+            if (lineStart == lineEnd || text[lineStart] == '#') continue;
+
+            size_t firstComma = text.find(',', lineStart);
+            size_t lastComma = text.rfind(',', lineEnd - 1);
+            if (firstComma >= lineEnd || lastComma == firstComma) {
+                error = "Universe file line " + to_string(lineNumber) + ": expected symbol,name,price";
+                return false;
+            }
+
+            size_t symbolStart = lineStart, symbolEnd = firstComma;
+            size_t nameStart = firstComma + 1, nameEnd = lastComma;
+            size_t priceStart = lastComma + 1;
+            trim(symbolStart, symbolEnd);
+            trim(nameStart, nameEnd);
+            while (priceStart < lineEnd && isspace((unsigned char)text[priceStart])) priceStart++;
+
+            // the price ends the (trimmed) line, so strtod must stop exactly at lineEnd
+            char* parsedEnd = nullptr;
+            double openingPrice = strtod(text.c_str() + priceStart, &parsedEnd);
+            bool numeric = priceStart < lineEnd && parsedEnd == text.c_str() + lineEnd;
+
+            if (!numeric && firstLine) {
+                firstLine = false;  // header
+                continue;
+            }
+            firstLine = false;
+
+            // strtod also reads "nan" and "inf", which are numbers here but never prices
+            if (symbolStart == symbolEnd || !numeric || !std::isfinite(openingPrice) || openingPrice <= 0) {
+                error = "Universe file line " + to_string(lineNumber) + ": bad symbol or price";
+                return false;
+            }
+            string_view symbol(text.data() + symbolStart, symbolEnd - symbolStart);
+            if (!seen.insert(symbol).second) {
+                error = "Universe file line " + to_string(lineNumber) + ": duplicate symbol " + string(symbol);
+                return false;
+            }
+
+            listings.push_back({string(symbol), text.substr(nameStart, nameEnd - nameStart), openingPrice});
+        }
+
+        if (listings.empty()) {
+            error = "Universe file " + path + " lists no tickers";
+            return false;
+        }
+        return true;
+    }
+
+    // Advance market one day
+    void advanceDay() {
+        currentDay++;
+        StockPriceGenerator* moves = priceGenerator();
+        double* cur = curPrices.data();
+        double* prev = prevPrices.data();
+
+        for (size_t i = 0; i < curPrices.size(); i++) {
+            prev[i] = cur[i];
+            cur[i] = moves->generate(cur[i], rng);
+            if (cur[i] < 0.01) {
+                cur[i] = 0.01;
+            }
+        }
+    }
+
+    // Advance one day to prices taken from a pre-generated path
+    // (one price per stock, in universe order) instead of generating them
+    void advanceDayTo(const double* prices) {
+        currentDay++;
+
+        std::copy(curPrices.begin(), curPrices.end(), prevPrices.begin());
+        std::copy(prices, prices + curPrices.size(), curPrices.begin());
+    }
+
+    // Back to day 1 and opening prices
+    void reset() {
+        currentDay = 1;
+
+        for (int i = 0; i < stocks.size(); i++) {
+            curPrices[i] = stocks[i].openingPrice;
+            prevPrices[i] = stocks[i].openingPrice;
+        }
+    }
+
+    // restart the price stream from a seed (for reproducible runs)
+    void setSeed(uint64_t seed) {
+        rng.setSeed(seed);
+    }
+
+    double getPrice(const string& symbol) const {
+        int index = indexOf(symbol);
+        return index < 0 ? 0 : curPrices[index];
+    }
+
+    // Position of a symbol in getStocks(), or -1 if it isn't listed
+    int indexOf(const string& symbol) const {
+        auto it = symbolIndex.find(symbol);
+        return it == symbolIndex.end() ? -1 : it->second;
+    }
+
+    // The factory's Stock object for a symbol, made on first request (nullptr if unlisted)
+    Stock* getStock(const string& symbol) {
+        int index = indexOf(symbol);
+        if (index < 0) return nullptr;
+
+        if (!stocks[index].stock) {
+            stocks[index].stock = factory->createStock(symbol);
+        }
+        return stocks[index].stock;
+    }
+
+    int getCurrentDay() const {
+        return currentDay;
+    }
+
+    // Identifies the current universe; a new value means getStocks() changed shape
+    uint64_t getUniverseId() const {
+        return universeId;
+    }
+
+    // Snapshot of the universe, prices, day and random stream
+    MarketState getState() const {
+        MarketState state;
+        state.currentDay = currentDay;
+        state.rngState = rng.getState();
+        state.listings.reserve(stocks.size());
+        state.cur = curPrices;
+        state.prev = prevPrices;
+
+        for (int i = 0; i < stocks.size(); i++) {
+            state.listings.push_back({stocks[i].ticker_symbol, stocks[i].name, stocks[i].openingPrice});
+        }
+        return state;
+    }
+
+    // Go back to a snapshot. The universe is only rebuilt if it differs, so
+    // restoring a market to an earlier day of the same run just copies prices.
+    bool restoreState(const MarketState& state) {
+        if (state.cur.size() != state.listings.size() || state.prev.size() != state.listings.size()) {
+            return false;
+        }
+
+        bool sameUniverse = (stocks.size() == state.listings.size());
+        for (int i = 0; sameUniverse && i < stocks.size(); i++) {
+            sameUniverse = stocks[i].ticker_symbol == state.listings[i].ticker_symbol &&
+                           stocks[i].name == state.listings[i].name &&
+                           stocks[i].openingPrice == state.listings[i].openingPrice;
+        }
+        if (!sameUniverse) {
+            loadUniverse(state.listings);
+            if (stocks.size() != state.listings.size()) return false;  // duplicate symbols
+        }
+
+        curPrices = state.cur;
+        prevPrices = state.prev;
+        currentDay = state.currentDay;
+        rng.setState(state.rngState);
+        return true;
+    }
+
+    StockTable getStocks() const {
+        return StockTable(curPrices.data(), prevPrices.data(), stocks.data(), (int)stocks.size());
+    }
+};
+
+#endif // STOCKMARKET_H
@@ -0,0 +1,299 @@
+// TableModels.cpp
+// Implementation of the GUI table models
+#include "TableModels.h"
+#include <QBrush>
+#include <QColor>
+
+namespace {
+
+QString money(double amount) {
+    return QString("$%1").arg(amount, 0, 'f', 2);
+}
+
+QVariant rightAligned() {
+    return QVariant(int(Qt::AlignRight | Qt::AlignVCenter));
+}
+
+}
+
+// --- Market ---
+
+MarketTableModel::MarketTableModel(QObject *parent) : QAbstractTableModel(parent) {
+}
+
+int MarketTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)stocks.size();
+}
+
+int MarketTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 5;
+}
+
+QVariant MarketTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= (int)stocks.size()) return QVariant();
+    const BankingTradingFacade::SimpleStockInfo &stock = stocks[index.row()];
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case 0: return QString::fromStdString(stock.symbol);
+            case 1: return QString::fromStdString(stock.name);
+            case 2: return money(stock.currentPrice);
+            case 3: return QString("%1%").arg(stock.percentChange, 0, 'f', 2);
+            case 4: return QString::fromStdString(stock.trend);
+        }
+    } else if (role == Qt::ForegroundRole && index.column() >= 3) {
+        if (stock.currentPrice > stock.previousPrice) return QBrush(QColor("#107c10"));
+        if (stock.currentPrice < stock.previousPrice) return QBrush(Qt::red);
+    } else if (role == Qt::TextAlignmentRole && (index.column() == 2 || index.column() == 3)) {
+        return rightAligned();
+    }
+    return QVariant();
+}
+
+QVariant MarketTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const char *headers[] = {"Symbol", "Company", "Price", "Change %", "Trend"};
+    return (section >= 0 && section < 5) ? QString(headers[section]) : QVariant();
+}
+
+void MarketTableModel::refresh() {
+    std::vector<BankingTradingFacade::SimpleStockInfo> latest = BankingTradingFacade::getInstance().getMarketData();
+
+    // A different universe is a different table
+    bool sameRows = latest.size() == stocks.size();
+    for (size_t i = 0; sameRows && i < latest.size(); i++) {
+        sameRows = latest[i].symbol == stocks[i].symbol;
+    }
+    if (!sameRows) {
+        beginResetModel();
+        stocks.swap(latest);
+        endResetModel();
+        return;
+    }
+
+    // Same tickers: report each run of rows whose prices moved
+    std::vector<std::pair<int, int>> changed;
+    for (size_t i = 0; i < latest.size(); i++) {
+        if (latest[i].currentPrice == stocks[i].currentPrice && latest[i].previousPrice == stocks[i].previousPrice) {
+            continue;
+        }
+        if (!changed.empty() && changed.back().second == (int)i - 1) {
+            changed.back().second = (int)i;
+        } else {
+            changed.push_back({(int)i, (int)i});
+        }
+    }
+
+    stocks.swap(latest);
+    for (const auto &run : changed) {
+        emit dataChanged(index(run.first, 2), index(run.second, 4));
+    }
+}
+
+// --- Portfolio ---
+
+PortfolioTableModel::PortfolioTableModel(QObject *parent) : QAbstractTableModel(parent) {
+}
+
+int PortfolioTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)holdings.size();
+}
+
+int PortfolioTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 5;
+}
+
+QVariant PortfolioTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= (int)holdings.size()) return QVariant();
+    const BankingTradingFacade::SimplePortfolioItem &h = holdings[index.row()];
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+            case 0: return QString::fromStdString(h.symbol);
+            case 1: return h.shares;
+            case 2: return money(h.averagePrice.toDouble());
+            case 3: return money(h.currentValue.toDouble());
+            case 4: return money(h.profit.toDouble());
+        }
+    } else if (role == Qt::ForegroundRole && index.column() == 4) {
+        return QBrush(h.profit >= Money() ? Qt::darkGreen : Qt::red);
+    } else if (role == Qt::TextAlignmentRole && index.column() > 0) {
+        return rightAligned();
+    }
+    return QVariant();
+}
+
+QVariant PortfolioTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const char *headers[] = {"Symbol", "Shares", "Avg Price", "Current Value", "Profit"};
+    return (section >= 0 && section < 5) ? QString(headers[section]) : QVariant();
+}
+
+void PortfolioTableModel::refresh() {
+    std::vector<BankingTradingFacade::SimplePortfolioItem> latest = BankingTradingFacade::getInstance().getPortfolio();
+
+    // A bought or sold-out position changes the rows themselves
+    bool sameRows = latest.size() == holdings.size();
+    for (size_t i = 0; sameRows && i < latest.size(); i++) {
+        sameRows = latest[i].symbol == holdings[i].symbol;
+    }
+    if (!sameRows) {
+        beginResetModel();
+        holdings.swap(latest);
+        endResetModel();
+        return;
+    }
+
+    std::vector<int> changed;
+    for (size_t i = 0; i < latest.size(); i++) {
+        const BankingTradingFacade::SimplePortfolioItem &a = latest[i];
+        const BankingTradingFacade::SimplePortfolioItem &b = holdings[i];
+        if (a.shares != b.shares || a.averagePrice != b.averagePrice || a.currentValue != b.currentValue) {
+            changed.push_back((int)i);
+        }
+    }
+
+    holdings.swap(latest);
+    for (int row : changed) {
+        emit dataChanged(index(row, 1), index(row, 4));
+    }
+}
+
+// --- Histories ---
+
+HistoryTableModel::HistoryTableModel(QObject *parent)
+    : QAbstractTableModel(parent), rows(0), pageOffset(0) {
+}
+
+int HistoryTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : (int)rows;
+}
+
+QVariant HistoryTableModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= (int)rows) return QVariant();
+    size_t row = index.row();
+
+    // fetch the page holding this row unless it is the cached one
+    if (row < pageOffset || row >= pageOffset + pageSize()) {
+        pageOffset = row / kPageSize * kPageSize;
+        fetchPage(pageOffset, kPageSize);
+        if (row >= pageOffset + pageSize()) return QVariant();
+    }
+    return pageData(row - pageOffset, index.column(), role);
+}
+
+void HistoryTableModel::refresh() {
+    size_t count = fetchCount();
+    std::string user = BankingTradingFacade::getInstance().getCurrentUser();
+
+    if (user != account || count < rows) {
+        beginResetModel();
+        account = user;
+        rows = count;
+        clearPage();
+        endResetModel();
+    } else if (count > rows) {
+        beginInsertRows(QModelIndex(), (int)rows, (int)count - 1);
+        rows = count;
+        endInsertRows();
+    }
+}
+
+void HistoryTableModel::reload() {
+    beginResetModel();
+    account = BankingTradingFacade::getInstance().getCurrentUser();
+    rows = fetchCount();
+    clearPage();
+    endResetModel();
+}
+
+// --- Trade history ---
+
+TradeHistoryModel::TradeHistoryModel(QObject *parent) : HistoryTableModel(parent) {
+}
+
+int TradeHistoryModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 7;
+}
+
+QVariant TradeHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const char *headers[] = {"Day", "Type", "Symbol", "Shares", "Price", "Total", "Reason"};
+    return (section >= 0 && section < 7) ? QString(headers[section]) : QVariant();
+}
+
+size_t TradeHistoryModel::fetchCount() const {
+    return BankingTradingFacade::getInstance().getTradeCount();
+}
+
+void TradeHistoryModel::fetchPage(size_t offset, size_t limit) const {
+    page = BankingTradingFacade::getInstance().getTradePage(offset, limit);
+}
+
+QVariant TradeHistoryModel::pageData(size_t row, int column, int role) const {
+    const BankingTradingFacade::SimpleTradeRecord &t = page[row];
+
+    if (role == Qt::DisplayRole) {
+        switch (column) {
+            case 0: return t.day;
+            case 1: return QString::fromStdString(t.type);
+            case 2: return QString::fromStdString(t.symbol);
+            case 3: return t.shares;
+            case 4: return money(t.price.toDouble());
+            case 5: return money(t.total.toDouble());
+            case 6: return QString::fromStdString(t.reason);
+        }
+    } else if (role == Qt::ForegroundRole && column == 1) {
+        return QBrush(t.type == "BUY" ? QColor("#0078d4") : QColor("#107c10"));
+    } else if (role == Qt::TextAlignmentRole && column != 1 && column != 2 && column != 6) {
+        return rightAligned();
+    }
+    return QVariant();
+}
+
+// --- Transaction history ---
+
+TransactionHistoryModel::TransactionHistoryModel(QObject *parent) : HistoryTableModel(parent) {
+}
+
+int TransactionHistoryModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 4;
+}
+
+QVariant TransactionHistoryModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    static const char *headers[] = {"Day", "Type", "Amount", "Description"};
+    return (section >= 0 && section < 4) ? QString(headers[section]) : QVariant();
+}
+
+size_t TransactionHistoryModel::fetchCount() const {
+    return BankingTradingFacade::getInstance().getTransactionCount();
+}
+
+void TransactionHistoryModel::fetchPage(size_t offset, size_t limit) const {
+    page = BankingTradingFacade::getInstance().getTransactionPage(offset, limit);
+}
+
+QVariant TransactionHistoryModel::pageData(size_t row, int column, int role) const {
+    const BankingTradingFacade::SimpleTransaction &trans = page[row];
+
+    if (role == Qt::DisplayRole) {
+        switch (column) {
+            case 0: return trans.day;
+            case 1: return QString::fromStdString(trans.type);
+            case 2: return money(trans.amount.toDouble());
+            case 3: return QString::fromStdString(trans.description);
+        }
+    } else if (role == Qt::TextAlignmentRole && (column == 0 || column == 2)) {
+        return rightAligned();
+    }
+    return QVariant();
+}
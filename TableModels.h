@@ -0,0 +1,127 @@
+// TableModels.h
+// Item models behind the GUI's market, portfolio and history tables. Views
+// only ask for the rows they draw, and a refresh tells them which rows
+// actually changed, so large universes and long histories stay responsive.
+#ifndef TABLEMODELS_H
+#define TABLEMODELS_H
+
+#include <QAbstractTableModel>
+#include <string>
+#include <vector>
+#include "BankingTradingFacade.h"
+
+// Every listed stock: Symbol, Company, Price, Change %, Trend
+class MarketTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit MarketTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Pull prices from the facade; only rows whose prices moved are reported changed
+    void refresh();
+
+private:
+    std::vector<BankingTradingFacade::SimpleStockInfo> stocks;
+};
+
+// Holdings of the logged-in account: Symbol, Shares, Avg Price, Current Value, Profit
+class PortfolioTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit PortfolioTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void refresh();
+
+private:
+    std::vector<BankingTradingFacade::SimplePortfolioItem> holdings;
+};
+
+/*
+    Append-only histories (trades, bank transactions) of the logged-in account.
+
+    Only the row count is kept up to date; rows are fetched from the facade a
+    page at a time when a view asks for them, and the last page is cached.
+    refresh() reports new rows as inserted at the end. If the history got
+    shorter or the account changed, the model is reset instead.
+*/
+class HistoryTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit HistoryTableModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void refresh();
+    void reload();  // drop everything and start over (after a reset)
+
+protected:
+    static const size_t kPageSize = 256;
+
+    virtual size_t fetchCount() const = 0;
+    virtual void fetchPage(size_t offset, size_t limit) const = 0;  // fills the subclass's page
+    virtual size_t pageSize() const = 0;                            // rows in that page
+    virtual QVariant pageData(size_t row, int column, int role) const = 0;
+    virtual void clearPage() const = 0;
+
+private:
+    size_t rows;
+    std::string account;          // whose history the rows belong to
+    mutable size_t pageOffset;    // first row of the cached page
+};
+
+// Trade history: Day, Type, Symbol, Shares, Price, Total, Reason
+class TradeHistoryModel : public HistoryTableModel {
+    Q_OBJECT
+
+public:
+    explicit TradeHistoryModel(QObject *parent = nullptr);
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+protected:
+    size_t fetchCount() const override;
+    void fetchPage(size_t offset, size_t limit) const override;
+    size_t pageSize() const override { return page.size(); }
+    QVariant pageData(size_t row, int column, int role) const override;
+    void clearPage() const override { page.clear(); }
+
+private:
+    mutable std::vector<BankingTradingFacade::SimpleTradeRecord> page;
+};
+
+// Bank transactions: Day, Type, Amount, Description
+class TransactionHistoryModel : public HistoryTableModel {
+    Q_OBJECT
+
+public:
+    explicit TransactionHistoryModel(QObject *parent = nullptr);
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+protected:
+    size_t fetchCount() const override;
+    void fetchPage(size_t offset, size_t limit) const override;
+    size_t pageSize() const override { return page.size(); }
+    QVariant pageData(size_t row, int column, int role) const override;
+    void clearPage() const override { page.clear(); }
+
+private:
+    mutable std::vector<BankingTradingFacade::SimpleTransaction> page;
+};
+
+#endif // TABLEMODELS_H
@@ -0,0 +1,56 @@
+// TimeSeriesStore.cpp
+// Implementation of the compressed price history
+
+#include "TimeSeriesStore.h"
+#include "StockMarket.h"
+
+bool TimeSeriesStore::recordPrices(const StockMarket& market) {
+    StockTable stocks = market.getStocks();
+
+    // map the market's universe onto series once per universe, not once per day
+    if (slotsUniverse_ != market.getUniverseId()) {
+        slots_.resize(stocks.size());
+        for (int i = 0; i < stocks.size(); i++) {
+            auto inserted = priceIndex_.emplace(stocks.info(i).ticker_symbol, prices_.size());
+            if (inserted.second) {
+                prices_.emplace_back();
+            }
+            slots_[i] = inserted.first->second;
+        }
+        slotsUniverse_ = market.getUniverseId();
+    }
+
+    int day = market.getCurrentDay();
+    const double* closes = stocks.curPrices();
+    bool recorded = false;
+    for (int i = 0; i < stocks.size(); i++) {
+        recorded |= prices_[slots_[i]].append(day, closes[i]);
+    }
+    return recorded;
+}
+
+const CompressedSeries* TimeSeriesStore::getPriceSeries(const std::string& symbol) const {
+    auto it = priceIndex_.find(symbol);
+    return it == priceIndex_.end() ? nullptr : &prices_[it->second];
+}
+
+size_t TimeSeriesStore::getPrices(const std::string& symbol, int fromDay, int toDay,
+                                  std::vector<int>& days, std::vector<double>& values) const {
+    const CompressedSeries* series = getPriceSeries(symbol);
+    return series ? series->getRange(fromDay, toDay, days, values) : 0;
+}
+
+size_t TimeSeriesStore::getMemoryBytes() const {
+    size_t bytes = 0;
+    for (const auto& series : prices_) {
+        bytes += series.getMemoryBytes();
+    }
+    return bytes;
+}
+
+void TimeSeriesStore::clear() {
+    prices_.clear();
+    priceIndex_.clear();
+    slots_.clear();
+    slotsUniverse_ = 0;
+}
@@ -0,0 +1,269 @@
+// TimeSeriesStore.h
+// Compressed per-day history. TimeSeriesStore keeps every ticker's closing
+// prices; each bot's equity curve is a CompressedSeries inside its
+// PerformanceTracker. Series are encoded the way Gorilla does it: days as
+// delta-of-deltas (one bit for consecutive days) and values XORed with the
+// previous one, keeping only the bits that changed. Points are grouped into
+// blocks that decode independently, so a range query jumps straight to the
+// first block it needs and streams from there.
+
+#ifndef TIMESERIESSTORE_H
+#define TIMESERIESSTORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class StockMarket;
+
+// One compressed series of (day, value) points with strictly increasing days
+class CompressedSeries {
+public:
+    static const uint32_t kBlockSize = 1024;  // points per independently decodable block
+
+    CompressedSeries() : bitCount_(0), count_(0), prevBits_(0), prevDelta_(0), leading_(0), trailing_(0) {}
+
+    // Add a point. Returns false (and stores nothing) unless day is after the last one.
+    bool append(int day, double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        if (blocks_.empty() || blocks_.back().count == kBlockSize) {
+            if (!blocks_.empty() && day <= blocks_.back().lastDay) return false;
+            blocks_.push_back({day, day, 1, bitCount_, value});
+            prevBits_ = bits;
+            prevDelta_ = 0;
+            leading_ = 0;
+            trailing_ = 0;  // no window yet: leading_ + trailing_ == 0
+            count_++;
+            return true;
+        }
+
+        Block& block = blocks_.back();
+        if (day <= block.lastDay) return false;
+
+        // day: delta-of-delta in growing buckets
+        int64_t delta = (int64_t)day - block.lastDay;
+        int64_t dod = delta - prevDelta_;
+        if (dod == 0) {
+            writeBits(0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            writeBits(0x2, 2);
+            writeBits((uint64_t)dod, 7);
+        } else if (dod >= -256 && dod <= 255) {
+            writeBits(0x6, 3);
+            writeBits((uint64_t)dod, 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            writeBits(0xE, 4);
+            writeBits((uint64_t)dod, 12);
+        } else {
+            writeBits(0xF, 4);
+            writeBits((uint64_t)dod, 32);
+        }
+        prevDelta_ = delta;
+
+        // value: XOR with the previous one, reusing its window of meaningful bits if it fits
+        uint64_t x = bits ^ prevBits_;
+        if (x == 0) {
+            writeBits(0, 1);
+        } else {
+            int leading = std::min(__builtin_clzll(x), 31);
+            int trailing = __builtin_ctzll(x);
+            if (leading_ + trailing_ > 0 && leading >= leading_ && trailing >= trailing_) {
+                writeBits(0x2, 2);
+                writeBits(x >> trailing_, 64 - leading_ - trailing_);
+            } else {
+                int meaningful = 64 - leading - trailing;
+                writeBits(0x3, 2);
+                writeBits((uint64_t)leading, 5);
+                writeBits((uint64_t)(meaningful - 1), 6);
+                writeBits(x >> trailing, meaningful);
+                leading_ = leading;
+                trailing_ = trailing;
+                if (leading_ + trailing_ == 0) trailing_ = 64;  // 64 meaningful bits: never reused
+            }
+        }
+        prevBits_ = bits;
+
+        block.lastDay = day;
+        block.count++;
+        count_++;
+        return true;
+    }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    int getFirstDay() const { return blocks_.empty() ? 0 : blocks_.front().firstDay; }
+    int getLastDay() const { return blocks_.empty() ? 0 : blocks_.back().lastDay; }
+
+    // Encoded size, block index included
+    size_t getMemoryBytes() const {
+        return words_.capacity() * sizeof(uint64_t) + blocks_.capacity() * sizeof(Block);
+    }
+
+    // Call visit(day, value) for every point with fromDay <= day <= toDay, oldest first
+    template <typename Visit>
+    void forEachInRange(int fromDay, int toDay, Visit visit) const {
+        if (fromDay > toDay) return;
+
+        auto first = std::lower_bound(blocks_.begin(), blocks_.end(), fromDay,
+                                      [](const Block& block, int day) { return block.lastDay < day; });
+
+        for (auto block = first; block != blocks_.end() && block->firstDay <= toDay; ++block) {
+            Reader in(words_.data(), block->bitOffset);
+            int day = block->firstDay;
+            uint64_t bits;
+            std::memcpy(&bits, &block->firstValue, sizeof(bits));
+            int64_t delta = 0;
+            int leading = 0, trailing = 0;
+
+            for (uint32_t i = 0; ; ) {
+                if (day > toDay) return;
+                if (day >= fromDay) {
+                    double value;
+                    std::memcpy(&value, &bits, sizeof(value));
+                    visit(day, value);
+                }
+                if (++i == block->count) break;
+
+                // day
+                int64_t dod = 0;
+                if (in.read(1)) {
+                    if (!in.read(1)) dod = in.readSigned(7);
+                    else if (!in.read(1)) dod = in.readSigned(9);
+                    else if (!in.read(1)) dod = in.readSigned(12);
+                    else dod = in.readSigned(32);
+                }
+                delta += dod;
+                day += (int)delta;
+
+                // value
+                if (in.read(1)) {
+                    if (in.read(1)) {
+                        leading = (int)in.read(5);
+                        int meaningful = (int)in.read(6) + 1;
+                        trailing = 64 - leading - meaningful;
+                    }
+                    bits ^= in.read(64 - leading - trailing) << trailing;
+                }
+            }
+        }
+    }
+
+    // Append the points in [fromDay, toDay] to days and values; returns how many
+    size_t getRange(int fromDay, int toDay, std::vector<int>& days, std::vector<double>& values) const {
+        size_t before = values.size();
+        forEachInRange(fromDay, toDay, [&](int day, double value) {
+            days.push_back(day);
+            values.push_back(value);
+        });
+        return values.size() - before;
+    }
+
+    void clear() {
+        words_.clear();
+        blocks_.clear();
+        bitCount_ = 0;
+        count_ = 0;
+    }
+
+private:
+    struct Block {
+        int32_t firstDay;
+        int32_t lastDay;
+        uint32_t count;
+        uint64_t bitOffset;   // where the block's second point starts in words_
+        double firstValue;
+    };
+
+    // MSB-first bit reader over the encoded words
+    class Reader {
+    public:
+        Reader(const uint64_t* words, uint64_t position) : words(words), position(position) {}
+
+        // n in [1, 64]
+        uint64_t read(int n) {
+            size_t word = position >> 6;
+            int used = (int)(position & 63);
+            int available = 64 - used;
+            position += n;
+
+            uint64_t high = (words[word] << used) >> (64 - n);
+            if (n <= available) return high;
+            return high | (words[word + 1] >> (64 - (n - available)));
+        }
+
+        int64_t readSigned(int n) {
+            uint64_t raw = read(n);
+            return (int64_t)(raw << (64 - n)) >> (64 - n);  // sign-extend
+        }
+
+    private:
+        const uint64_t* words;
+        uint64_t position;
+    };
+
+    // Low n bits of value, n in [1, 64]
+    void writeBits(uint64_t value, int n) {
+        if (n < 64) value &= (1ull << n) - 1;
+
+        int used = (int)(bitCount_ & 63);
+        if (used == 0) words_.push_back(0);
+        int available = 64 - used;
+
+        if (n <= available) {
+            words_.back() |= value << (available - n);
+        } else {
+            words_.back() |= value >> (n - available);
+            words_.push_back(value << (64 - (n - available)));
+        }
+        bitCount_ += n;
+    }
+
+    std::vector<uint64_t> words_;
+    std::vector<Block> blocks_;
+    uint64_t bitCount_;
+    size_t count_;
+
+    // Encoder state for the open block
+    uint64_t prevBits_;
+    int64_t prevDelta_;
+    int leading_;             // window of the last explicitly sized XOR
+    int trailing_;
+};
+
+
+/*
+    Daily closing prices of a market, one series per ticker.
+
+    recordPrices() appends the market's current prices. The universe is mapped
+    onto series once, so recording a day is one pass over the price column.
+    Tickers that leave the universe keep their history.
+*/
+class TimeSeriesStore {
+public:
+    // Closing prices of every listed ticker for the market's current day.
+    // Returns false if that day was already recorded.
+    bool recordPrices(const StockMarket& market);
+
+    // nullptr if the ticker was never recorded
+    const CompressedSeries* getPriceSeries(const std::string& symbol) const;
+
+    // Append the ticker's closes in [fromDay, toDay] to days and values; returns how many
+    size_t getPrices(const std::string& symbol, int fromDay, int toDay,
+                     std::vector<int>& days, std::vector<double>& values) const;
+
+    size_t getMemoryBytes() const;
+    void clear();
+
+private:
+    std::vector<CompressedSeries> prices_;                  // one per ticker ever recorded
+    std::unordered_map<std::string, size_t> priceIndex_;    // symbol -> prices_ index
+    std::vector<size_t> slots_;                             // market index -> prices_ index
+    uint64_t slotsUniverse_ = 0;                            // StockMarket::getUniverseId slots_ was built for
+};
+
+#endif // TIMESERIESSTORE_H
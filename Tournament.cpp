@@ -0,0 +1,121 @@
+// Tournament.cpp
+// Implementation of the shared-market strategy tournament
+
+#include "Tournament.h"
+#include "BotScheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <ostream>
+
+std::vector<TournamentStanding> Tournament::run(const TournamentConfig& config) {
+    const size_t count = config.entries.size();
+
+    StockMarket market(config.seed);
+    if (!config.universe.empty()) {
+        market.loadUniverse(config.universe);
+    }
+
+    // One account and one bot per entry, all on the same market
+    BankingSystem bank;
+    BotScheduler scheduler(market, config.threads);
+    std::vector<std::unique_ptr<TradingBot>> bots;
+    bots.reserve(count);
+
+    for (size_t i = 0; i < count; i++) {
+        const TournamentEntry& entry = config.entries[i];
+        std::string account = "entry" + std::to_string(i + 1);
+        bank.registerUser(account, "", config.initialBalance);
+
+        TradingBot* bot = new TradingBot(market, bank, account);
+        bots.emplace_back(bot);
+        if (entry.customParams) {
+            bot->setStrategyParams("Aggressive", entry.params);
+            bot->setStrategyParams("Conservative", entry.params);
+        }
+        bot->setAutoSwitch(entry.strategy == "auto");
+        bot->setStrategy(entry.strategy == "aggressive" ? "Aggressive" : "Conservative");
+        bot->startBot();
+        scheduler.addBot(bot);
+    }
+
+    // Each day: prices are generated once, then every entry trades on them
+    for (int day = 0; day < config.days; day++) {
+        scheduler.advanceDay();
+    }
+
+    std::vector<TournamentStanding> standings(count);
+    for (size_t i = 0; i < count; i++) {
+        TradingBot& bot = *bots[i];
+        Money equity = bot.getAvailableBalance() + bot.getHoldingsValue();
+        Money traded;
+        for (const auto& trade : bot.getHistory()) {
+            traded += trade.total;
+        }
+
+        TournamentStanding& standing = standings[i];
+        standing.entry = config.entries[i];
+        standing.profit = (equity - config.initialBalance).toDouble();
+        standing.returnPct = standing.profit / config.initialBalance.toDouble() * 100.0;
+        standing.maxDrawdown = bot.getPerformanceStats().maxDrawdown;
+        standing.turnover = traded.toDouble() / config.initialBalance.toDouble();
+        standing.trades = bot.getTradeCount();
+    }
+
+    std::stable_sort(standings.begin(), standings.end(), [](const TournamentStanding& a, const TournamentStanding& b) {
+        return a.profit > b.profit;
+    });
+    return standings;
+}
+
+bool Tournament::parseEntry(const std::string& text, TournamentEntry& entry) {
+    entry = TournamentEntry();
+    entry.name = text;
+
+    size_t colon = text.find(':');
+    entry.strategy = text.substr(0, colon);
+    if (entry.strategy != "auto" && entry.strategy != "aggressive" && entry.strategy != "conservative") {
+        return false;
+    }
+    if (colon == std::string::npos) return true;
+
+    // takeProfit:stopLoss:maxHoldings
+    const char* cursor = text.c_str() + colon + 1;
+    char* end = nullptr;
+    entry.params.takeProfit = std::strtod(cursor, &end);
+    if (end == cursor || *end != ':') return false;
+    cursor = end + 1;
+    entry.params.stopLoss = std::strtod(cursor, &end);
+    if (end == cursor || *end != ':') return false;
+    cursor = end + 1;
+    long holdings = std::strtol(cursor, &end, 10);
+    if (end == cursor || *end != '\0' || holdings <= 0) return false;
+
+    entry.params.maxHoldings = (int)holdings;
+    entry.customParams = true;
+    return true;
+}
+
+void Tournament::writeCsv(std::ostream& out, const std::vector<TournamentStanding>& standings, size_t top) {
+    out << "rank,entry,strategy,take_profit,stop_loss,max_holdings,profit,return_pct,"
+           "max_drawdown,turnover,trades\n";
+
+    size_t rows = (top == 0) ? standings.size() : std::min(top, standings.size());
+    char line[512];
+    for (size_t i = 0; i < rows; i++) {
+        const TournamentStanding& s = standings[i];
+        const TournamentEntry& e = s.entry;
+
+        // entries on strategy defaults leave the threshold columns empty
+        char params[96] = ",,";
+        if (e.customParams) {
+            std::snprintf(params, sizeof(params), "%.4f,%.4f,%d",
+                          e.params.takeProfit, e.params.stopLoss, e.params.maxHoldings);
+        }
+        std::snprintf(line, sizeof(line), "%zu,%s,%s,%s,%.2f,%.2f,%.4f,%.2f,%d\n",
+                      i + 1, e.name.c_str(), e.strategy.c_str(), params, s.profit, s.returnPct,
+                      s.maxDrawdown, s.turnover, s.trades);
+        out << line;
+    }
+}
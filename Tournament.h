@@ -0,0 +1,56 @@
+// Tournament.h
+// Head-to-head comparison of many strategies on one market. A single market
+// generates each day's prices once; every entry has its own bot, portfolio
+// and account on that market, and a BotScheduler runs the entries' trading
+// cycles for the day in parallel. The result is a leaderboard of profit, drawdown and turnover.
+
+#ifndef TOURNAMENT_H
+#define TOURNAMENT_H
+
+#include "TradingBot.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// One competitor: a strategy, optionally with its own thresholds
+struct TournamentEntry {
+    std::string name;                   // label on the leaderboard
+    std::string strategy;               // "auto", "aggressive" or "conservative"
+    bool customParams = false;          // false keeps each strategy's defaults
+    StrategyParams params = {0, 0, 0};
+};
+
+struct TournamentConfig {
+    std::vector<TournamentEntry> entries;
+    int days = 252;
+    uint64_t seed = 42;
+    Money initialBalance = Money::units(10000);
+    std::vector<StockListing> universe; // empty uses the built-in tickers
+    unsigned threads = 0;               // 0 = all hardware threads
+};
+
+// Final standing of one entry
+struct TournamentStanding {
+    TournamentEntry entry;
+    double profit;          // ending equity minus starting balance
+    double returnPct;       // profit as a percentage of the starting balance
+    double maxDrawdown;     // largest peak-to-trough drop of daily equity, as a fraction
+    double turnover;        // value traded (buys plus sells) over the starting balance
+    int trades;
+};
+
+class Tournament {
+public:
+    // Play every entry through config.days; standings are sorted best profit first
+    std::vector<TournamentStanding> run(const TournamentConfig& config);
+
+    // Parse "strategy" or "strategy:takeProfit:stopLoss:maxHoldings".
+    // Returns false on bad input.
+    static bool parseEntry(const std::string& text, TournamentEntry& entry);
+
+    // Write the leaderboard as CSV (top == 0 writes every row)
+    static void writeCsv(std::ostream& out, const std::vector<TournamentStanding>& standings, size_t top);
+};
+
+#endif // TOURNAMENT_H
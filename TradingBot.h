@@ -1,706 +1,861 @@
-#ifndef TRADINGBOTFUNC_H
-#define TRADINGBOTFUNC_H
-
-#include "StockAbstractFactory.h"
-#include "BankingSystem.h"
-#include <string>
-#include <vector>
-#include <algorithm>
-#include <unordered_map>
-
-using namespace std;
-
-struct StockFields {
-    Stock *stock;
-    StockPriceGenerator *generator;
-    string ticker_symbol;
-    string name;
-    double cur;
-    double prev;
-    double openingPrice;
-
-
-    // checks if stock price went up or down during that day
-    bool priceDown() const {
-        return cur < prev;
-    }
-
-    bool priceUp() const {
-        return cur > prev;
-    }
-
-
-    //get change in percentage of current price from the day before
-    double getPercentChange() {
-        if(prev == 0) {
-            return 0.0;
-        }
-
-        return ((cur - prev) / prev) * 100.0;
-    }
-
-};
-
-
-
-struct StockRanks {
-    string ticker_symbol;
-    double cur;
-    double score;
-    int recommendedShares;
-};
-
-struct TradeRecords {
-    string type;
-    string ticker_symbol;
-    int shares;
-    double cost;
-    double total;
-    int day;
-    string reason;
-
-};
-
-
-struct Portfolio {
-
-    string ticker_symbol;
-    int shares;
-    double averageCost;
-    double totalCost;
-
-
-    double getValue(double cost) const {
-        return shares * cost;
-    }
-
-    double getProfits(double cost) const {
-        return getValue(cost) - totalCost;
-    }
-
-    double getProfitPercent(double cost) const {
-        if (totalCost <= 0) {
-            return 0.0;
-        }
-
-        return (getProfits(cost) / totalCost) * 100.0;
-    }
-
-
-};
-
-
-class TradeStrategy {
-public:
-    virtual ~TradeStrategy() = default;
-
-    virtual vector<StockRanks> rankStocks(const vector<StockFields>& stocks, double balance) = 0;
-
-    virtual double getTakeProfit() const = 0;  // When to sell for profit
-
-    virtual double getStopLoss() const = 0;    // When to sell to prevent loss
-
-    virtual int getMaxHoldings() const = 0; //the maximum amount of holdings you can buy
-    
-    virtual string getStrategyName() const = 0; //getter for the current strategy being used
-
-};
-
-/*
-
-    A simple strategy where the bot buys stocks that are currently down.
-    Simulates a person buying during a dip in stock price hoping to earn more.
-    Will sell if profit is greater than the set percetage amount or if the loss is around or greater than 10%.
-
-*/
-class AggressiveStrategy : public TradeStrategy {
-
-public:
-    vector<StockRanks> rankStocks(const vector<StockFields>& stocks, double balance) override {
-
-        vector<StockRanks> stockRankings;
-
-        for (const auto& stock : stocks) {
-
-            StockRanks theRank;
-            theRank.ticker_symbol = stock.ticker_symbol;
-            theRank.cur = stock.cur;
-
-
-            if (stock.priceDown()) {
-                theRank.score = 100;
-            } else {
-                theRank.score = 0;
-            }
-
-
-            theRank.recommendedShares = (int)((balance*0.25) / stock.cur);
-
-            if (theRank.recommendedShares < 1) theRank.recommendedShares = 1;
-
-            stockRankings.push_back(theRank);
-
-        }
-
-        sort(stockRankings.begin(), stockRankings.end(), [](const StockRanks& a, const StockRanks& b) {
-            return a.score > b.score;
-        });
-
-        return stockRankings;
-    }
-
-    string getStrategyName() const override {
-        return "Aggressive";
-    }
-    double getTakeProfit() const override {
-        return 0.15;
-    }  // Sell at 15% profit
-
-    double getStopLoss() const override {
-        return -0.10;
-    }   // Sell at 10% loss
-    int getMaxHoldings() const override {
-        return 3;
-    }       // Max 3 stocks
-};
-
-
-/*
-
-    A simple strategy where the bot buys stocks that are currently up.
-    Simulates a person buying during a safe time where they follow the trend of stock optimism.
-    Will sell if profit is greater than the set percetage amount or if the loss is around or greater than 3%.
-
-*/
-class ConservativeStrategy : public TradeStrategy {
-
-public:
-    vector<StockRanks> rankStocks(const vector<StockFields>& stocks, double balance) override {
-
-        vector<StockRanks> stockRankings;
-
-        for (const auto& stock : stocks) {
-
-            StockRanks theRank;
-            theRank.ticker_symbol = stock.ticker_symbol;
-            theRank.cur = stock.cur;
-
-
-            if (stock.priceUp()) {
-                theRank.score = 100;
-            } else {
-                theRank.score = 0;
-            }
-
-
-            theRank.recommendedShares = (int)((balance*0.25) / stock.cur);
-
-            if (theRank.recommendedShares < 1) theRank.recommendedShares = 1;
-
-            stockRankings.push_back(theRank);
-
-        }
-
-        sort(stockRankings.begin(), stockRankings.end(), [](const StockRanks& a, const StockRanks& b) {
-            return a.score > b.score;
-        });
-
-        return stockRankings;
-    }
-
-    string getStrategyName() const override {
-        return "Conservative";
-    }
-
-    // sells when there is a 5% margin of profit
-    double getTakeProfit() const override {
-        return 0.05;
-    }
-
-    // sells when there is a loss of 3%
-    double getStopLoss() const override {
-        return -0.03;
-    }
-    // need
-    int getMaxHoldings() const override {
-        return 5;
-    }
-};
-
-
-/*
-    Analyses the stock market simulation. Labels the current day as BEARISH where stock prices in the sim are going down.
-    Day is labeled BULLISH if stock prices in the sim are going up in the day.
-
-    Simple count of stocks. More stocks that day that went up = BULLISH, otherwise the day is labeled BEARISH
-
-*/
-class StockMarketAnalyser {
-public:
-    enum Condition { BULLISH, BEARISH };
-
-
-    Condition analyzeMarket(const vector<StockFields>& stocks) {
-
-        int upCount = 0;
-
-        int downCount = 0;
-
-        for (const auto& stock : stocks) {
-            if (stock.priceUp()) upCount++;
-            else if (stock.priceDown()) downCount++;
-        }
-
-        // If more stocks went up, market is bullish
-        if (upCount >= downCount) {
-            return BULLISH;
-        } else {
-            return BEARISH;
-        }
-    }
-
-    // function to tell bot that market conditions are good and to perform appropriate strategy
-    bool goAggressive(Condition state) {
-        return (state == BULLISH);
-    }
-
-    // returns the market condition as a string
-    string stringCondition(Condition state) {
-        if (state == BULLISH) {
-            return "BULLISH";
-        }
-
-        return "BEARISH";
-    }
-};
-
-
-/*
-    Trading Bot logic implementation
-
-*/
-
-class TradingBot {
-private:
-
-    vector<StockFields> stocks;
-    unordered_map<string, Portfolio> portfolio;
-    vector<TradeRecords> history;
-    vector<StockRanks> rankings;
-
-    bool running;
-    bool autoSwitch;
-    int currentDay;
-    double realizedProfit;
-    string marketCondition;
-
-    StockAbstractFactory* factory;
-    TradeStrategy* strategy;
-    StockMarketAnalyser analyser;
-
-
-
-    // Private constructor using a Singleton
-    //this inititates the trading bot and simulation. Default Conservative.
-    TradingBot() {
-
-        running = false;
-        autoSwitch = true;
-        currentDay = 1;
-        realizedProfit = 0;
-        marketCondition = "UNKNOWN";
-
-        factory = new SimpleStockFactory();
-        strategy = new ConservativeStrategy();
-
-        addStock("GOOG", "Alphabet", 320.12);
-        addStock("AMZN", "Amazon", 233.22);
-        addStock("NVDA", "Nvidia", 176.98);
-        addStock("MSFT", "Microsoft", 491.92);
-        addStock("META", "Meta Platforms", 647.95);
-        addStock("GME", "GameStop Corp", 22.53);
-        addStock("TSLA", "Tesla Inc", 430.17);
-        addStock("GM", "General Motors", 45.00);
-        addStock("F", "Ford Motor Co", 13.28);
-        addStock("WMT", "Walmart Inc", 110.51);
-        addStock("YELP", "Yelp Inc", 28.91);
-        addStock("SONY", "Sony Group Corp", 29.35);
-        addStock("MCD", "McDonalds Corp", 311.82);
-        addStock("CSUSM", "San Marcos", 100.00);
-    }
-
-    void addStock(string symbol, string name, double price) {
-
-        StockFields s;
-        s.ticker_symbol = symbol;
-        s.name = name;
-        s.cur = price;
-        s.prev = price;
-        s.openingPrice = price;
-        s.stock = factory->createStock(symbol);
-        s.generator = factory->createPriceGenerator();
-        stocks.push_back(s);
-    }
-
-
-
-    // check the current portfolio for stocks to sell
-    void checkSells() {
-        vector<string> toSell;
-
-        for (auto& p : portfolio) {
-            double price = getPrice(p.first);
-            double profitPct = p.second.getProfitPercent(price) / 100.0;
-
-            if (profitPct >= strategy->getTakeProfit()) {
-                toSell.push_back(p.first);
-            }
-            else if (profitPct <= strategy->getStopLoss()) {
-                toSell.push_back(p.first);
-            }
-        }
-
-        // Sell them
-        for (int i = 0; i < toSell.size(); i++) {
-            string symbol = toSell[i];
-
-            int shares = portfolio[symbol].shares;
-
-            double price = getPrice(symbol);
-
-            double profitPct = portfolio[symbol].getProfitPercent(price) / 100.0;
-
-            string reason = (profitPct > 0) ? "Take profit" : "Stop loss";
-            sell(symbol, shares, reason);
-        }
-    }
-
-    // check for stocks to buy
-    void checkBuys() {
-        int holdings = portfolio.size();
-
-        for (int i = 0; i < rankings.size(); i++) {
-            if (rankings[i].score <= 0) continue;
-            if (portfolio.count(rankings[i].ticker_symbol)) continue;
-
-            //check to see if we have the max amount of holdings
-            if (holdings >= strategy->getMaxHoldings()) break;
-
-            // Gets the reason for the bot buying the stock. This will be displayed.
-            if (buy(rankings[i].ticker_symbol, rankings[i].recommendedShares, strategy->getStrategyName() + " pick")) {
-                holdings++;
-            }
-        }
-    }
-
-public:
-
-    static TradingBot& getInstance() {
-        static TradingBot instance;
-        return instance;
-    }
-
-    // Delete copy
-    TradingBot(TradingBot&) = delete;
-
-    void operator=(TradingBot&) = delete;
-
-    // Used in MainWindow.cpp to check bot status. Bot is ON
-    void startBot() {
-
-        running = true;
-
-    }
-
-    // same thing for this function. Bot is OFF.
-    void stopBot() {
-
-        running = false;
-
-    }
-
-    // same thing here. Used in MainWindow.cpp
-    bool isRunning() {
-
-        return running;
-
-    }
-
-    // getter for the strategy being used
-    string getName() {
-        return strategy->getStrategyName();
-    }
-
-    double getPrice(string symbol) {
-
-        for (int i = 0; i < stocks.size(); i++) {
-            if (stocks[i].ticker_symbol == symbol) {
-                return stocks[i].cur;
-            }
-        }
-        return 0;
-    }
-
-    /*
-
-        Important function that allows switching strategies during the simulation
-
-    */
-    void strategySwitch() {
-        // checks current sim conditions (Bullish or Bearish markets)
-        StockMarketAnalyser::Condition condition = analyser.analyzeMarket(stocks);
-
-        // string conversion to display condition
-        marketCondition = analyser.stringCondition(condition);
-
-        // check how agggressive we should be investing
-        bool needAggressive = analyser.goAggressive(condition);
-
-        bool isAggressive = (strategy->getStrategyName() == "Aggressive");
-
-        // Condition: If conditions are favorable switch strategies
-        if (needAggressive && !isAggressive) {
-            delete strategy;
-            strategy = new AggressiveStrategy();
-        }
-
-        //go back to default conservative if needed here
-        else if (!needAggressive && isAggressive) {
-            delete strategy;
-            strategy = new ConservativeStrategy();
-        }
-    }
-
-    // Advance market one day
-    void advanceDay() {
-        currentDay++;
-
-        for (int i = 0; i < stocks.size(); i++) {
-            stocks[i].prev = stocks[i].cur;
-            stocks[i].cur = stocks[i].generator->generate(stocks[i].cur);
-            if (stocks[i].cur < 0.01) {
-                stocks[i].cur = 0.01;
-            }
-        }
-    }
-
-    // Main trading cycle
-    void executeTradingCycle() {
-        // check the bot is still running
-        if (!running) return;
-
-        if (autoSwitch) strategySwitch();
-
-        double balance = getAvailableBalance();
-
-        rankings = strategy->rankStocks(stocks, balance);
-
-        checkSells();
-        checkBuys();
-    }
-
-    // logic for the bot to buy the shares
-    bool buy(string symbol, int shares, string reason) {
-        if (shares <= 0) return false;
-
-        double price = getPrice(symbol);
-        double cost = price * shares;
-
-        BankingSystem& bank = BankingSystem::getInstance();
-        if (cost > bank.getBalance()) return false;
-        if (!bank.withdraw(cost, "Buy " + symbol, currentDay)) return false;
-
-        // Update portfolio
-        if (portfolio.count(symbol)) {
-            portfolio[symbol].averageCost = (portfolio[symbol].totalCost + cost) / (portfolio[symbol].shares + shares);
-            portfolio[symbol].shares += shares;
-            portfolio[symbol].totalCost += cost;
-        } else {
-            Portfolio h;
-            h.ticker_symbol = symbol;
-            h.shares = shares;
-            h.averageCost = price;
-            h.totalCost = cost;
-            portfolio[symbol] = h;
-        }
-
-        TradeRecords t;
-        t.type = "BUY";
-        t.ticker_symbol = symbol;
-        t.shares = shares;
-        t.cost = price;
-        t.total = cost;
-        t.day = currentDay;
-        t.reason = reason;
-        history.push_back(t);
-
-        return true;
-    }
-
-    // logic for bot to sell shares
-    bool sell(string symbol, int shares, string reason) {
-        if (shares <= 0) return false;
-        if (!portfolio.count(symbol)) return false;
-        if (portfolio[symbol].shares < shares) return false;
-
-        double price = getPrice(symbol);
-        double revenue = price * shares;
-
-        BankingSystem& bank = BankingSystem::getInstance();
-        if (!bank.deposit(revenue, "Sell " + symbol, currentDay)) return false;
-
-        // Calculate the profits from selling the update the portfolio
-        double costBasis = portfolio[symbol].averageCost * shares;
-        realizedProfit += revenue - costBasis;
-
-        portfolio[symbol].shares -= shares;
-
-        portfolio[symbol].totalCost -= costBasis;
-
-        // Get rid of the stock symbol from portfolio if no shares owned
-
-        if (portfolio[symbol].shares <= 0) {
-            portfolio.erase(symbol);
-        }
-
-        TradeRecords t;
-
-        t.type = "SELL";
-
-        t.ticker_symbol = symbol;
-        t.shares = shares;
-        t.cost = price;
-        t.total = revenue;
-        t.day = currentDay;
-        t.reason = reason;
-        history.push_back(t);
-
-        return true;
-    }
-
-    // Sell everything if desperate
-    //not sure if this is need  in current interation..
-    void liquidateAll() {
-        vector<pair<string, int>> toSell;
-
-        for (auto& p : portfolio) {
-            toSell.push_back({p.first, p.second.shares});
-        }
-
-        for (int i = 0; i < toSell.size(); i++) {
-            sell(toSell[i].first, toSell[i].second, "Liquidation");
-        }
-    }
-
-    // Sell only profitable positions
-    void liquidateProfitableOnly() {
-        vector<pair<string, int>> toSell;
-        for (auto& p : portfolio) {
-            double price = getPrice(p.first);
-            if (p.second.getProfits(price) > 0) {
-                toSell.push_back({p.first, p.second.shares});
-            }
-        }
-        for (int i = 0; i < toSell.size(); i++) {
-            sell(toSell[i].first, toSell[i].second, "Take profit");
-        }
-    }
-
-    // Try to end with profit
-    bool tryEndWithProfit(int maxWaitDays, int currentWaitDay) {
-        liquidateProfitableOnly();
-        if (portfolio.empty()) return true;
-
-        // maxWaitdays implementation if auto run bot here?
-        // sell all if reaching max days
-        if (currentWaitDay >= maxWaitDays) {
-            liquidateAll();
-            return true;
-        }
-        return false;
-    }
-
-    // Getters for data gathering
-    double getAvailableBalance() {
-        return BankingSystem::getInstance().getBalance();
-    }
-
-    double getProfit() {
-        double unrealized = 0;
-        for (auto& p : portfolio) {
-            double price = getPrice(p.first);
-            unrealized += p.second.getProfits(price);
-        }
-        return realizedProfit + unrealized;
-    }
-
-    int getTotalShares() {
-        int total = 0;
-        for (auto& p : portfolio) {
-            total += p.second.shares;
-        }
-        return total;
-    }
-
-    int getCurrentDay() { 
-        return currentDay; 
-    }
-
-    string getMarketCondition() { 
-        return marketCondition; 
-    }
-
-    vector<StockFields> getAllStocks() { 
-        return stocks; 
-    }
-
-    vector<TradeRecords> getHistory() { 
-        return history; 
-    }
-
-    vector<StockRanks> getRankings() { 
-        return rankings; 
-    }
-
-    vector<Portfolio> getPortfolio() {
-
-        vector<Portfolio> result;
-
-        for (auto& p : portfolio) {
-
-            result.push_back(p.second);
-
-        }
-        return result;
-    }
-
-    void setAutoSwitch(bool enabled) {
-
-        autoSwitch = enabled;
-
-    }
-
-    // Reset for new simulation, go back to default Strategy.
-    void reset() {
-        running = false;
-        currentDay = 1;
-        realizedProfit = 0;
-        marketCondition = "UNKNOWN";
-        portfolio.clear();
-        history.clear();
-        rankings.clear();
-
-        delete strategy;
-        strategy = new ConservativeStrategy();
-
-        for (int i = 0; i < stocks.size(); i++) {
-            stocks[i].cur = stocks[i].openingPrice;
-            stocks[i].prev = stocks[i].openingPrice;
-        }
-    }
-
-};
-
-
-
-#endif
+#ifndef TRADINGBOTFUNC_H
+#define TRADINGBOTFUNC_H
+
+#include "StockMarket.h"
+#include "ScoringKernel.h"
+#include "PerformanceTracker.h"
+#include "BankingSystem.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std;
+
+struct StockRanks {
+    string ticker_symbol;
+    double cur;
+    double score;
+    int recommendedShares;
+};
+
+struct TradeRecords {
+    string type;
+    string ticker_symbol;
+    int shares;
+    Money cost;     // price per share
+    Money total;
+    int day;
+    string reason;
+
+};
+
+
+struct Portfolio {
+
+    string ticker_symbol;
+    int shares;
+    Money averageCost;
+    Money totalCost;
+
+
+    Money getValue(double cost) const {
+        return Money::fromDouble(cost) * shares;
+    }
+
+    Money getProfits(double cost) const {
+        return getValue(cost) - totalCost;
+    }
+
+    double getProfitPercent(double cost) const {
+        if (totalCost <= Money()) {
+            return 0.0;
+        }
+
+        return (getProfits(cost).toDouble() / totalCost.toDouble()) * 100.0;
+    }
+
+
+};
+
+
+// Exit and sizing thresholds of a strategy
+struct StrategyParams {
+    double takeProfit;  // sell once profit reaches this fraction (0.15 = 15%)
+    double stopLoss;    // sell once loss reaches this fraction (-0.10 = -10%)
+    int maxHoldings;    // maximum number of different stocks held
+};
+
+
+// Everything a bot carries between trading cycles (see TradingBot::getState)
+struct BotState {
+    string account;
+    bool running;
+    bool autoSwitch;
+    Money realizedProfit;
+    string marketCondition;
+    string strategy;              // name of the active strategy
+    StrategyParams aggressiveParams;
+    StrategyParams conservativeParams;
+    vector<Portfolio> portfolio;
+    vector<TradeRecords> history;
+    vector<StockRanks> rankings;
+    PerformanceTracker performance;
+};
+
+
+class TradeStrategy {
+private:
+    // scratch columns for rankByMove, reused between trading cycles
+    vector<double> scores;
+    vector<int32_t> shares;
+    vector<int32_t> picks;
+
+protected:
+    // The stocks whose price made `move` today, in universe order, each sized
+    // to a quarter of the balance. Scored in one pass over the price columns.
+    vector<StockRanks> rankByMove(const StockTable& stocks, double balance, PriceMove move) {
+        int count = stocks.size();
+        scores.resize(count);
+        shares.resize(count);
+        picks.resize(count);
+
+        int picked = scoreStocks(stocks.curPrices(), stocks.prevPrices(), count, move, balance * 0.25,
+                                 scores.data(), shares.data(), picks.data());
+
+        vector<StockRanks> stockRankings;
+        stockRankings.reserve(picked);
+        for (int k = 0; k < picked; k++) {
+            int i = picks[k];
+            stockRankings.push_back({stocks.info(i).ticker_symbol, stocks.curPrices()[i], scores[i], shares[i]});
+        }
+        return stockRankings;
+    }
+
+public:
+    virtual ~TradeStrategy() = default;
+
+    // The stocks worth buying today, best first
+    virtual vector<StockRanks> rankStocks(const StockTable& stocks, double balance) = 0;
+
+    virtual double getTakeProfit() const = 0;  // When to sell for profit
+
+    virtual double getStopLoss() const = 0;    // When to sell to prevent loss
+
+    virtual int getMaxHoldings() const = 0; //the maximum amount of holdings you can buy
+    
+    virtual string getStrategyName() const = 0; //getter for the current strategy being used
+
+};
+
+/*
+
+    A simple strategy where the bot buys stocks that are currently down.
+    Simulates a person buying during a dip in stock price hoping to earn more.
+    Will sell if profit is greater than the set percetage amount or if the loss is around or greater than 10%.
+
+*/
+class AggressiveStrategy : public TradeStrategy {
+private:
+    StrategyParams params;
+
+public:
+    // Sell at 15% profit or 10% loss, max 3 stocks
+    static StrategyParams defaults() {
+        return {0.15, -0.10, 3};
+    }
+
+    explicit AggressiveStrategy(const StrategyParams& p = defaults()) : params(p) {}
+
+    // every stock that went down today, equally scored
+    vector<StockRanks> rankStocks(const StockTable& stocks, double balance) override {
+        return rankByMove(stocks, balance, PriceMove::DOWN);
+    }
+
+    string getStrategyName() const override {
+        return "Aggressive";
+    }
+    double getTakeProfit() const override {
+        return params.takeProfit;
+    }
+
+    double getStopLoss() const override {
+        return params.stopLoss;
+    }
+    int getMaxHoldings() const override {
+        return params.maxHoldings;
+    }
+};
+
+
+/*
+
+    A simple strategy where the bot buys stocks that are currently up.
+    Simulates a person buying during a safe time where they follow the trend of stock optimism.
+    Will sell if profit is greater than the set percetage amount or if the loss is around or greater than 3%.
+
+*/
+class ConservativeStrategy : public TradeStrategy {
+private:
+    StrategyParams params;
+
+public:
+    // Sell at 5% profit or 3% loss, max 5 stocks
+    static StrategyParams defaults() {
+        return {0.05, -0.03, 5};
+    }
+
+    explicit ConservativeStrategy(const StrategyParams& p = defaults()) : params(p) {}
+
+    // every stock that went up today, equally scored
+    vector<StockRanks> rankStocks(const StockTable& stocks, double balance) override {
+        return rankByMove(stocks, balance, PriceMove::UP);
+    }
+
+    string getStrategyName() const override {
+        return "Conservative";
+    }
+
+    // sells when the profit margin reaches takeProfit
+    double getTakeProfit() const override {
+        return params.takeProfit;
+    }
+
+    // sells when the loss reaches stopLoss
+    double getStopLoss() const override {
+        return params.stopLoss;
+    }
+
+    int getMaxHoldings() const override {
+        return params.maxHoldings;
+    }
+};
+
+
+/*
+    Analyses the stock market simulation. Labels the current day as BEARISH where stock prices in the sim are going down.
+    Day is labeled BULLISH if stock prices in the sim are going up in the day.
+
+    Simple count of stocks. More stocks that day that went up = BULLISH, otherwise the day is labeled BEARISH
+
+*/
+class StockMarketAnalyser {
+public:
+    enum Condition { BULLISH, BEARISH };
+
+
+    Condition analyzeMarket(const StockTable& stocks) {
+
+        int upCount = 0;
+
+        int downCount = 0;
+
+        // only the price columns are needed, not the stocks' descriptions
+        const double* cur = stocks.curPrices();
+        const double* prev = stocks.prevPrices();
+        for (int i = 0; i < stocks.size(); i++) {
+            upCount += cur[i] > prev[i];
+            downCount += cur[i] < prev[i];
+        }
+
+        // If more stocks went up, market is bullish
+        if (upCount >= downCount) {
+            return BULLISH;
+        } else {
+            return BEARISH;
+        }
+    }
+
+    // function to tell bot that market conditions are good and to perform appropriate strategy
+    bool goAggressive(Condition state) {
+        return (state == BULLISH);
+    }
+
+    // returns the market condition as a string
+    string stringCondition(Condition state) {
+        if (state == BULLISH) {
+            return "BULLISH";
+        }
+
+        return "BEARISH";
+    }
+};
+
+
+/*
+    Trading Bot logic implementation
+
+*/
+
+class TradingBot {
+private:
+
+    unordered_map<string, Portfolio> portfolio;
+    vector<TradeRecords> history;
+    vector<StockRanks> rankings;
+
+    bool running;
+    bool autoSwitch;
+    Money realizedProfit;
+    string marketCondition;
+    PerformanceTracker performance;  // equity curve and trade statistics, updated as they happen
+
+    TradeStrategy* strategy;
+    StockMarketAnalyser analyser;
+
+    StockMarket* market;          // market the bot reads prices from
+    bool ownsMarket;              // standalone bots own their market, per-account bots share one
+    BankingSystem& bank;          // bank the bot trades against
+    string account;               // account it trades for ("" = the bank's logged-in user)
+    AccountHandle session;        // handle to `account`, so trades skip the username lookup
+
+    StrategyParams aggressiveParams;
+    StrategyParams conservativeParams;
+
+    // Orders planned by checkSells/checkBuys, settled with the bank as one batch
+    vector<TradeRecords> pendingOrders;
+    Money pendingCash;            // available cash once the planned orders settle
+
+    // build a strategy by name with this bot's parameters (nullptr for unknown names)
+    TradeStrategy* makeStrategy(const string& name) const {
+        if (name == "Aggressive") return new AggressiveStrategy(aggressiveParams);
+        if (name == "Conservative") return new ConservativeStrategy(conservativeParams);
+        return nullptr;
+    }
+
+    // shared constructor body. Default Conservative.
+    void init() {
+
+        running = false;
+        autoSwitch = true;
+        realizedProfit = Money();
+        marketCondition = "UNKNOWN";
+        pendingCash = Money();
+
+        aggressiveParams = AggressiveStrategy::defaults();
+        conservativeParams = ConservativeStrategy::defaults();
+
+        strategy = makeStrategy("Conservative");
+    }
+
+    // Bank access for this bot's account
+    AccountHandle accountSession() const {
+        return account.empty() ? bank.getCurrentSession() : session;
+    }
+
+    Money accountBalance() const {
+        return accountSession().getBalance();
+    }
+
+    // Plan a trade against pendingCash without touching the bank
+    bool queueBuy(const string& symbol, int shares, const string& reason) {
+        if (shares <= 0) return false;
+
+        Money price = Money::fromDouble(getPrice(symbol));
+        Money cost = price * shares;
+        if (cost > pendingCash) return false;
+
+        pendingOrders.push_back({"BUY", symbol, shares, price, cost, getCurrentDay(), reason});
+        pendingCash -= cost;
+        return true;
+    }
+
+    void queueSell(const string& symbol, int shares, const string& reason) {
+        Money price = Money::fromDouble(getPrice(symbol));
+        Money revenue = price * shares;
+
+        pendingOrders.push_back({"SELL", symbol, shares, price, revenue, getCurrentDay(), reason});
+        pendingCash += revenue;
+    }
+
+    bool hasPendingSale(const string& symbol) const {
+        for (const auto& order : pendingOrders) {
+            if (order.type == "SELL" && order.ticker_symbol == symbol) return true;
+        }
+        return false;
+    }
+
+    // Settle the orders with the bank in one critical section. The portfolio and
+    // history only change if the bank accepted every order.
+    bool settle(const vector<TradeRecords>& orders) {
+        if (orders.empty()) return true;
+
+        vector<Settlement> batch;
+        batch.reserve(orders.size());
+        for (const auto& order : orders) {
+            if (order.type == "BUY") {
+                batch.push_back({Transaction::STOCK_PURCHASE, -order.total, "Buy " + order.ticker_symbol});
+            } else {
+                batch.push_back({Transaction::STOCK_SALE, order.total, "Sell " + order.ticker_symbol});
+            }
+        }
+
+        if (!accountSession().settleBatch(batch, getCurrentDay())) return false;
+
+        for (const auto& order : orders) {
+            applyTrade(order);
+        }
+        return true;
+    }
+
+    // Book a settled trade in the portfolio and history
+    void applyTrade(const TradeRecords& t) {
+        const string& symbol = t.ticker_symbol;
+
+        if (t.type == "BUY") {
+            if (portfolio.count(symbol)) {
+                portfolio[symbol].averageCost = (portfolio[symbol].totalCost + t.total) / (portfolio[symbol].shares + t.shares);
+                portfolio[symbol].shares += t.shares;
+                portfolio[symbol].totalCost += t.total;
+            } else {
+                Portfolio h;
+                h.ticker_symbol = symbol;
+                h.shares = t.shares;
+                h.averageCost = t.cost;
+                h.totalCost = t.total;
+                portfolio[symbol] = h;
+            }
+            performance.recordBuy(t.total);
+        } else {
+            // Calculate the profits from selling the update the portfolio
+            Money costBasis = portfolio[symbol].averageCost * t.shares;
+            realizedProfit += t.total - costBasis;
+            performance.recordSell(t.total, (t.total - costBasis).toDouble());
+
+            portfolio[symbol].shares -= t.shares;
+            portfolio[symbol].totalCost -= costBasis;
+
+            // Get rid of the stock symbol from portfolio if no shares owned
+            if (portfolio[symbol].shares <= 0) {
+                portfolio.erase(symbol);
+            }
+        }
+
+        history.push_back(t);
+    }
+
+
+public:
+
+    // Sell/buy passes of a trading cycle. They only plan orders; settlePendingOrders()
+    // sends them to the bank. Public so they can be benchmarked on their own.
+
+    // start planning a cycle against `balance`, dropping any unsettled orders
+    void beginOrders(Money balance) {
+        pendingOrders.clear();
+        pendingCash = balance;
+    }
+
+    // check the current portfolio for stocks to sell
+    void checkSells() {
+        for (auto& p : portfolio) {
+            double price = getPrice(p.first);
+            double profitPct = p.second.getProfitPercent(price) / 100.0;
+
+            if (profitPct >= strategy->getTakeProfit() || profitPct <= strategy->getStopLoss()) {
+                string reason = (profitPct > 0) ? "Take profit" : "Stop loss";
+                queueSell(p.first, p.second.shares, reason);
+            }
+        }
+    }
+
+    // check for stocks to buy, paying from the cash left after planned sells
+    void checkBuys() {
+        int holdings = portfolio.size();
+        for (const auto& order : pendingOrders) {
+            if (order.type == "SELL") holdings--;  // planned sells close whole positions
+        }
+
+        for (int i = 0; i < rankings.size(); i++) {
+            const string& symbol = rankings[i].ticker_symbol;
+            if (rankings[i].score <= 0) continue;
+            if (portfolio.count(symbol) && !hasPendingSale(symbol)) continue;
+
+            //check to see if we have the max amount of holdings
+            if (holdings >= strategy->getMaxHoldings()) break;
+
+            // Gets the reason for the bot buying the stock. This will be displayed.
+            if (queueBuy(symbol, rankings[i].recommendedShares, strategy->getStrategyName() + " pick")) {
+                holdings++;
+            }
+        }
+    }
+
+    // Settle every planned order with the bank, all or nothing. If the account
+    // changed since planning and can no longer cover the batch, nothing is traded.
+    bool settlePendingOrders() {
+        bool settled = settle(pendingOrders);
+        pendingOrders.clear();
+        return settled;
+    }
+
+    // Standalone bot for simulations: owns its market (seeded price stream) and
+    // trades for the bank's logged-in user.
+    TradingBot(BankingSystem& bankingSystem, uint64_t seed)
+        : market(new StockMarket(seed)), ownsMarket(true), bank(bankingSystem) {
+        init();
+    }
+
+    // Per-account bot: reads a market shared with other bots and trades for one
+    // named account. The market is advanced by the caller (see BotScheduler).
+    TradingBot(StockMarket& sharedMarket, BankingSystem& bankingSystem, const string& accountName)
+        : market(&sharedMarket), ownsMarket(false), bank(bankingSystem), account(accountName),
+          session(bankingSystem.getAccount(accountName)) {
+        init();
+    }
+
+    ~TradingBot() {
+        delete strategy;
+        if (ownsMarket) delete market;
+    }
+
+    // Delete copy
+    TradingBot(TradingBot&) = delete;
+
+    void operator=(TradingBot&) = delete;
+
+    // Used in MainWindow.cpp to check bot status. Bot is ON
+    void startBot() {
+
+        running = true;
+
+    }
+
+    // same thing for this function. Bot is OFF.
+    void stopBot() {
+
+        running = false;
+
+    }
+
+    // same thing here. Used in MainWindow.cpp
+    bool isRunning() {
+
+        return running;
+
+    }
+
+    // getter for the strategy being used
+    string getName() {
+        return strategy->getStrategyName();
+    }
+
+    double getPrice(string symbol) {
+        return market->getPrice(symbol);
+    }
+
+    const string& getAccount() const {
+        return account;
+    }
+
+    StockMarket& getMarket() {
+        return *market;
+    }
+
+    /*
+
+        Important function that allows switching strategies during the simulation
+
+    */
+    void strategySwitch() {
+        // checks current sim conditions (Bullish or Bearish markets)
+        StockMarketAnalyser::Condition condition = analyser.analyzeMarket(market->getStocks());
+
+        // string conversion to display condition
+        marketCondition = analyser.stringCondition(condition);
+
+        // check how agggressive we should be investing
+        bool needAggressive = analyser.goAggressive(condition);
+
+        bool isAggressive = (strategy->getStrategyName() == "Aggressive");
+
+        // Condition: If conditions are favorable switch strategies
+        if (needAggressive && !isAggressive) {
+            delete strategy;
+            strategy = makeStrategy("Aggressive");
+        }
+
+        //go back to default conservative if needed here
+        else if (!needAggressive && isAggressive) {
+            delete strategy;
+            strategy = makeStrategy("Conservative");
+        }
+    }
+
+    // Advance this bot's own market one day. Bots sharing a market must not call
+    // this; the scheduler advances the shared market once for all of them.
+    void advanceDay() {
+        market->advanceDay();
+    }
+
+    // Advance this bot's own market to prices from a pre-generated path
+    void advanceDayTo(const double* prices) {
+        market->advanceDayTo(prices);
+    }
+
+    // Main trading cycle
+    void executeTradingCycle() {
+        // a stopped bot doesn't trade, but its holdings still move with the
+        // market, so it still takes the day's equity sample
+        if (!running) {
+            recordEquity();
+            return;
+        }
+
+        if (autoSwitch) strategySwitch();
+
+        Money balance = getAvailableBalance();
+
+        rankings = strategy->rankStocks(market->getStocks(), balance.toDouble());
+
+        // plan against one balance snapshot, then settle the whole cycle at once
+        beginOrders(balance);
+        checkSells();
+        checkBuys();
+        settlePendingOrders();
+
+        // the day's equity sample, after the day's trades
+        recordEquity();
+    }
+
+    void recordEquity() {
+        performance.recordDay(getCurrentDay(), accountBalance(), getHoldingsValue());
+    }
+
+    // logic for the bot to buy the shares
+    bool buy(string symbol, int shares, string reason) {
+        if (shares <= 0) return false;
+
+        Money price = Money::fromDouble(getPrice(symbol));
+        return settle({{"BUY", symbol, shares, price, price * shares, getCurrentDay(), reason}});
+    }
+
+    // logic for bot to sell shares
+    bool sell(string symbol, int shares, string reason) {
+        if (shares <= 0) return false;
+        if (!portfolio.count(symbol)) return false;
+        if (portfolio[symbol].shares < shares) return false;
+
+        Money price = Money::fromDouble(getPrice(symbol));
+        return settle({{"SELL", symbol, shares, price, price * shares, getCurrentDay(), reason}});
+    }
+
+    // Sell everything if desperate
+    //not sure if this is need  in current interation..
+    void liquidateAll() {
+        pendingOrders.clear();
+        for (auto& p : portfolio) {
+            queueSell(p.first, p.second.shares, "Liquidation");
+        }
+        settlePendingOrders();
+    }
+
+    // Sell only profitable positions
+    void liquidateProfitableOnly() {
+        pendingOrders.clear();
+        for (auto& p : portfolio) {
+            double price = getPrice(p.first);
+            if (p.second.getProfits(price) > Money()) {
+                queueSell(p.first, p.second.shares, "Take profit");
+            }
+        }
+        settlePendingOrders();
+    }
+
+    // Try to end with profit
+    bool tryEndWithProfit(int maxWaitDays, int currentWaitDay) {
+        liquidateProfitableOnly();
+        if (portfolio.empty()) return true;
+
+        // maxWaitdays implementation if auto run bot here?
+        // sell all if reaching max days
+        if (currentWaitDay >= maxWaitDays) {
+            liquidateAll();
+            return true;
+        }
+        return false;
+    }
+
+    // Getters for data gathering
+    Money getAvailableBalance() {
+        return accountBalance();
+    }
+
+    Money getProfit() {
+        Money unrealized;
+        for (auto& p : portfolio) {
+            double price = getPrice(p.first);
+            unrealized += p.second.getProfits(price);
+        }
+        return realizedProfit + unrealized;
+    }
+
+    // market value of everything currently held
+    Money getHoldingsValue() {
+        Money value;
+        for (auto& p : portfolio) {
+            value += p.second.getValue(getPrice(p.first));
+        }
+        return value;
+    }
+
+    int getTotalShares() {
+        int total = 0;
+        for (auto& p : portfolio) {
+            total += p.second.shares;
+        }
+        return total;
+    }
+
+    int getCurrentDay() const { 
+        return market->getCurrentDay(); 
+    }
+
+    string getMarketCondition() { 
+        return marketCondition; 
+    }
+
+    StockTable getAllStocks() { 
+        return market->getStocks(); 
+    }
+
+    vector<TradeRecords> getHistory() { 
+        return history; 
+    }
+
+    // number of trades so far, without copying the history
+    int getTradeCount() const {
+        return (int)history.size();
+    }
+
+    // Up to `limit` trades starting at `offset` (0 = oldest)
+    vector<TradeRecords> getHistoryPage(size_t offset, size_t limit) const {
+        if (offset >= history.size()) return {};
+        size_t end = offset + min(limit, history.size() - offset);
+        return vector<TradeRecords>(history.begin() + offset, history.begin() + end);
+    }
+
+    vector<StockRanks> getRankings() { 
+        return rankings; 
+    }
+
+    // Analytics over the days this bot traded, without walking the history
+    PerformanceStats getPerformanceStats() const {
+        return performance.getStats();
+    }
+
+    const CompressedSeries& getEquityCurve() const {
+        return performance.getEquityCurve();
+    }
+
+    vector<Portfolio> getPortfolio() {
+
+        vector<Portfolio> result;
+
+        for (auto& p : portfolio) {
+
+            result.push_back(p.second);
+
+        }
+        return result;
+    }
+
+    // restart the price stream from a seed (for reproducible runs)
+    void setSeed(uint64_t seed) {
+        market->setSeed(seed);
+    }
+
+    void setAutoSwitch(bool enabled) {
+
+        autoSwitch = enabled;
+
+    }
+
+    // pick a strategy by name ("Aggressive" or "Conservative"). Returns false for unknown names.
+    bool setStrategy(const string& name) {
+        TradeStrategy* chosen = makeStrategy(name);
+        if (!chosen) return false;
+
+        delete strategy;
+        strategy = chosen;
+        return true;
+    }
+
+    // change the thresholds used by a strategy ("Aggressive" or "Conservative").
+    // Takes effect for the active strategy immediately and for every later switch.
+    bool setStrategyParams(const string& name, const StrategyParams& params) {
+        if (name == "Aggressive") {
+            aggressiveParams = params;
+        } else if (name == "Conservative") {
+            conservativeParams = params;
+        } else {
+            return false;
+        }
+
+        if (strategy->getStrategyName() == name) {
+            setStrategy(name);
+        }
+        return true;
+    }
+
+    // Replace the tradable stocks with a new universe. Portfolio and history are left alone,
+    // so this is meant to be followed by reset() for a fresh run.
+    void loadUniverse(const vector<StockListing>& listings) {
+        market->loadUniverse(listings);
+    }
+
+    // Snapshot of the bot's own state. Its market is saved separately, since
+    // per-account bots share one. Without history, the trade history and the
+    // equity curve are left out (performance keeps only its totals), so the
+    // snapshot stays small however long the bot has run.
+    BotState getState(bool withHistory = true) const {
+        BotState state;
+        state.account = account;
+        state.running = running;
+        state.autoSwitch = autoSwitch;
+        state.realizedProfit = realizedProfit;
+        state.marketCondition = marketCondition;
+        state.strategy = strategy->getStrategyName();
+        state.aggressiveParams = aggressiveParams;
+        state.conservativeParams = conservativeParams;
+        if (withHistory) state.history = history;
+        state.rankings = rankings;
+        state.performance = withHistory ? performance
+                                        : PerformanceTracker(performance.getTotals(), CompressedSeries());
+
+        state.portfolio.reserve(portfolio.size());
+        for (const auto& p : portfolio) {
+            state.portfolio.push_back(p.second);
+        }
+        return state;
+    }
+
+    // Go back to a snapshot (the account it trades for stays the same)
+    bool restoreState(const BotState& state) {
+        aggressiveParams = state.aggressiveParams;
+        conservativeParams = state.conservativeParams;
+        if (!setStrategy(state.strategy)) return false;
+
+        running = state.running;
+        autoSwitch = state.autoSwitch;
+        realizedProfit = state.realizedProfit;
+        marketCondition = state.marketCondition;
+        history = state.history;
+        rankings = state.rankings;
+        performance = state.performance;
+        pendingOrders.clear();
+        pendingCash = Money();
+
+        portfolio.clear();
+        for (const auto& holding : state.portfolio) {
+            portfolio[holding.ticker_symbol] = holding;
+        }
+        return true;
+    }
+
+    // Reset for new simulation, go back to default Strategy.
+    void reset() {
+        running = false;
+        realizedProfit = Money();
+        marketCondition = "UNKNOWN";
+        portfolio.clear();
+        history.clear();
+        rankings.clear();
+        performance.reset();
+        pendingOrders.clear();
+        pendingCash = Money();
+
+        delete strategy;
+        strategy = makeStrategy("Conservative");
+
+        // a shared market is reset by its owner, not by each bot
+        if (ownsMarket) {
+            market->reset();
+        }
+    }
+
+};
+
+
+
+#endif
@@ -0,0 +1,162 @@
+// WorkStealingPool.h
+// Fixed-size thread pool with one task deque per worker. A worker pops its own
+// deque from the back and, when it runs dry, steals from the front of the others,
+// so uneven simulations still keep every core busy.
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // threads == 0 means one worker per hardware thread
+    explicit WorkStealingPool(unsigned threads = 0) : queued_(0), pending_(0), nextQueue_(0), stopping_(false) {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned i = 0; i < threads; i++) {
+            queues_.push_back(std::make_unique<TaskQueue>());
+        }
+        for (unsigned i = 0; i < threads; i++) {
+            workers_.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            stopping_ = true;
+        }
+        idleCv_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return (unsigned)workers_.size(); }
+
+    // Queue a task. Tasks submitted from a worker go to that worker's own deque.
+    void submit(std::function<void()> task) {
+        unsigned index = (currentPool_ == this) ? currentWorker_
+                                                : nextQueue_.fetch_add(1) % queues_.size();
+        pending_.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(idleMutex_);
+            queued_++;
+        }
+        idleCv_.notify_one();
+    }
+
+    // Block until every submitted task has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(idleMutex_);
+        doneCv_.wait(lock, [this]() { return pending_.load() == 0; });
+    }
+
+    // Run body(i) for i in [0, count), split into roughly 4 chunks per worker, and wait
+    void parallelFor(size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) return;
+
+        size_t chunks = std::min(count, (size_t)size() * 4);
+        size_t chunkSize = (count + chunks - 1) / chunks;
+
+        for (size_t begin = 0; begin < count; begin += chunkSize) {
+            size_t end = std::min(count, begin + chunkSize);
+            submit([&body, begin, end]() {
+                for (size_t i = begin; i < end; i++) {
+                    body(i);
+                }
+            });
+        }
+        wait();
+    }
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // Own deque first (LIFO keeps caches warm), then steal the oldest task elsewhere
+    bool takeTask(unsigned self, std::function<void()>& task) {
+        {
+            TaskQueue& own = *queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t offset = 1; offset < queues_.size(); offset++) {
+            TaskQueue& victim = *queues_[(self + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(unsigned index) {
+        currentPool_ = this;
+        currentWorker_ = index;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(idleMutex_);
+                idleCv_.wait(lock, [this]() { return stopping_ || queued_ > 0; });
+                if (queued_ == 0) return;  // stopping and nothing left
+                queued_--;
+            }
+
+            // A task is reserved for us; it may still be in flight into a deque
+            std::function<void()> task;
+            while (!takeTask(index, task)) {
+                std::this_thread::yield();
+            }
+
+            task();
+
+            if (pending_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(idleMutex_);
+                doneCv_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    size_t queued_;                  // tasks in deques not yet claimed (guarded by idleMutex_)
+    std::atomic<size_t> pending_;    // tasks submitted but not finished
+    std::atomic<unsigned> nextQueue_;
+    bool stopping_;
+
+    std::mutex idleMutex_;
+    std::condition_variable idleCv_;
+    std::condition_variable doneCv_;
+
+    static inline thread_local WorkStealingPool* currentPool_ = nullptr;
+    static inline thread_local unsigned currentWorker_ = 0;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,494 @@
+// WriteAheadLog.cpp
+// Implementation of the BankingSystem journal (POSIX file I/O)
+
+#include "WriteAheadLog.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+// File layout (native byte order):
+//   header  u32 magic, u32 version, u64 generation
+//   record  u32 payload length, u32 CRC32 of payload, payload
+//   payload u8 kind, u32 account, i64 amount, u8 type, i32 day, i64 timestamp,
+//           then username, password and description as u32 length + bytes
+const uint32_t kMagic = 0x4C4E4A53;  // "SJNL"
+const uint32_t kVersion = 1;
+const size_t kHeaderSize = 16;
+const size_t kFrameSize = 8;
+const size_t kFixedPayloadSize = 1 + 4 + 8 + 1 + 4 + 8 + 3 * 4;
+
+// CRC32 (IEEE), eight bytes per step ("slicing-by-8")
+struct CrcTable {
+    uint32_t entries[8][256];
+
+    CrcTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int slice = 1; slice < 8; slice++) {
+                uint32_t previous = entries[slice - 1][i];
+                entries[slice][i] = (previous >> 8) ^ entries[0][previous & 0xFF];
+            }
+        }
+    }
+};
+
+const CrcTable crcTable;
+
+uint32_t crc32(const char* data, size_t size) {
+    const uint32_t (*t)[256] = crcTable.entries;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (size >= 8) {
+        uint32_t low, high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        low ^= crc;  // little-endian byte order
+        crc = t[7][low & 0xFF] ^ t[6][(low >> 8) & 0xFF] ^ t[5][(low >> 16) & 0xFF] ^ t[4][low >> 24] ^
+              t[3][high & 0xFF] ^ t[2][(high >> 8) & 0xFF] ^ t[1][(high >> 16) & 0xFF] ^ t[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        crc = t[0][(crc ^ (uint8_t)*data++) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template <typename T>
+void put(std::vector<char>& out, T value) {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+char* put(char* out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+char* putText(char* out, std::string_view text) {
+    out = put<uint32_t>(out, (uint32_t)text.size());
+    std::memcpy(out, text.data(), text.size());
+    return out + text.size();
+}
+
+template <typename T>
+T get(const char*& data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+// Append one framed record to `out`. The CRC is left for sealFrames(), so the
+// appending thread doesn't pay for it.
+void encode(const JournalRecord& record, std::vector<char>& out) {
+    uint32_t length = (uint32_t)(kFixedPayloadSize + record.username.size() +
+                                 record.password.size() + record.description.size());
+    size_t start = out.size();
+    out.resize(start + kFrameSize + length);
+
+    char* payload = out.data() + start + kFrameSize;
+    char* cursor = payload;
+    cursor = put<uint8_t>(cursor, record.kind);
+    cursor = put<uint32_t>(cursor, record.account);
+    cursor = put<int64_t>(cursor, record.amount);
+    cursor = put<uint8_t>(cursor, record.type);
+    cursor = put<int32_t>(cursor, record.day);
+    cursor = put<int64_t>(cursor, record.timestamp);
+    cursor = putText(cursor, record.username);
+    cursor = putText(cursor, record.password);
+    putText(cursor, record.description);
+
+    char* frame = out.data() + start;
+    frame = put<uint32_t>(frame, length);
+    put<uint32_t>(frame, 0);
+}
+
+// Fill in the CRC of every frame in a batch of encoded records
+void sealFrames(std::vector<char>& batch) {
+    size_t offset = 0;
+    while (offset < batch.size()) {
+        char* frame = batch.data() + offset;
+        uint32_t length;
+        std::memcpy(&length, frame, 4);
+        uint32_t crc = crc32(frame + kFrameSize, length);
+        std::memcpy(frame + 4, &crc, 4);
+        offset += kFrameSize + length;
+    }
+}
+
+bool decode(const char* data, size_t size, JournalRecord& record) {
+    if (size < kFixedPayloadSize) return false;
+    const char* end = data + size;
+
+    record.kind = (JournalRecord::Kind)get<uint8_t>(data);
+    record.account = get<uint32_t>(data);
+    record.amount = get<int64_t>(data);
+    record.type = get<uint8_t>(data);
+    record.day = get<int32_t>(data);
+    record.timestamp = get<int64_t>(data);
+
+    std::string_view* texts[] = {&record.username, &record.password, &record.description};
+    for (std::string_view* text : texts) {
+        if (end - data < 4) return false;
+        uint32_t length = get<uint32_t>(data);
+        if ((size_t)(end - data) < length) return false;
+        *text = std::string_view(data, length);
+        data += length;
+    }
+    return data == end;
+}
+
+std::vector<char> header(uint64_t generation) {
+    std::vector<char> out;
+    put<uint32_t>(out, kMagic);
+    put<uint32_t>(out, kVersion);
+    put<uint64_t>(out, generation);
+    return out;
+}
+
+// Length of the intact part of a journal file (0 if the header is bad).
+// Stops at the first record that is cut short or fails its CRC.
+size_t scan(const std::vector<char>& file, uint64_t& generation) {
+    generation = 0;
+    if (file.size() < kHeaderSize) return 0;
+
+    const char* data = file.data();
+    if (get<uint32_t>(data) != kMagic || get<uint32_t>(data) != kVersion) return 0;
+    generation = get<uint64_t>(data);
+
+    size_t offset = kHeaderSize;
+    while (file.size() - offset >= kFrameSize) {
+        const char* frame = file.data() + offset;
+        uint32_t length = get<uint32_t>(frame);
+        uint32_t crc = get<uint32_t>(frame);
+        if (file.size() - offset - kFrameSize < length || crc32(frame, length) != crc) break;
+        offset += kFrameSize + length;
+    }
+    return offset;
+}
+
+void replay(const std::vector<char>& file, size_t validBytes,
+            const std::function<void(const JournalRecord&)>& apply) {
+    JournalRecord record;
+    size_t offset = kHeaderSize;
+    while (offset < validBytes) {
+        const char* frame = file.data() + offset;
+        uint32_t length = get<uint32_t>(frame);
+        frame += 4;  // CRC, already checked by scan()
+        if (decode(frame, length, record)) {
+            apply(record);
+        }
+        offset += kFrameSize + length;
+    }
+}
+
+bool readFile(const std::string& path, std::vector<char>& out) {
+    out.clear();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    char buffer[1 << 16];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        out.insert(out.end(), buffer, buffer + count);
+    }
+    std::fclose(file);
+    return true;
+}
+
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+// Make a rename inside `directory` durable
+void syncDirectory(const std::string& directory) {
+    int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+}
+
+WriteAheadLog::WriteAheadLog(const std::string& directory, const JournalOptions& options)
+    : directory_(directory), options_(options), fd_(-1), generation_(0),
+      appended_(0), pendingBytes_(0), logBytes_(0), failed_(false), durable_(0), flushing_(false),
+      syncRequested_(false), stopping_(false), snapshotFd_(-1), snapshotFailed_(false) {}
+
+WriteAheadLog::~WriteAheadLog() {
+    if (flusher_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        flushWanted_.notify_one();
+        flusher_.join();  // the flusher writes what is pending before it exits
+    }
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool WriteAheadLog::open(const std::function<void(const JournalRecord&)>& apply) {
+    if (fd_ >= 0) return false;
+    if (::mkdir(directory_.c_str(), 0755) != 0 && errno != EEXIST) return false;
+
+    // The snapshot is renamed into place whole, so any damage means it can't be trusted
+    std::vector<char> file;
+    uint64_t snapshotGeneration = 0;
+    if (readFile(directory_ + "/snapshot.bin", file)) {
+        if (scan(file, snapshotGeneration) != file.size() || file.empty()) return false;
+        replay(file, file.size(), apply);
+    }
+
+    // A log older than the snapshot was already folded into it
+    uint64_t logGeneration = 0;
+    size_t validBytes = readFile(directory_ + "/journal.log", file) ? scan(file, logGeneration) : 0;
+    if (validBytes == 0 || logGeneration < snapshotGeneration) {
+        if (!startLog(std::max<uint64_t>(snapshotGeneration, 1))) return false;
+    } else {
+        replay(file, validBytes, apply);
+
+        // Drop a torn record left by a crash, then carry on appending
+        std::string path = directory_ + "/journal.log";
+        fd_ = ::open(path.c_str(), O_WRONLY | O_APPEND);
+        if (fd_ < 0) return false;
+        if (validBytes < file.size() && (::ftruncate(fd_, validBytes) != 0 || ::fsync(fd_) != 0)) {
+            ::close(fd_);
+            fd_ = -1;
+            return false;
+        }
+
+        generation_ = logGeneration;
+        logBytes_ = validBytes - kHeaderSize;
+    }
+
+    flusher_ = std::thread(&WriteAheadLog::flushLoop, this);
+    return true;
+}
+
+// Replace journal.log with an empty log of the given generation
+bool WriteAheadLog::startLog(uint64_t generation) {
+    std::string path = directory_ + "/journal.log";
+    std::string temporary = path + ".tmp";
+
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    std::vector<char> head = header(generation);
+    if (!writeAll(fd, head.data(), head.size()) || ::fsync(fd) != 0 ||
+        ::rename(temporary.c_str(), path.c_str()) != 0) {
+        ::close(fd);
+        return false;
+    }
+    syncDirectory(directory_);
+
+    // the descriptor still refers to the renamed file; append from here on
+    ::close(fd);
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (fd < 0) return false;
+
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = fd;
+    generation_ = generation;
+    logBytes_ = 0;
+    return true;
+}
+
+uint64_t WriteAheadLog::append(const JournalRecord& record) {
+    if (failed_) return 0;
+
+    Lane& lane = lanes_[record.account % kLaneCount];
+    uint64_t sequence;
+    size_t size;
+    {
+        std::lock_guard<std::mutex> laneLock(lane.mutex);
+        size_t before = lane.pending.size();
+        encode(record, lane.pending);
+        size = lane.pending.size() - before;
+        // counted only once the bytes are in the lane, so the flusher finds
+        // every record up to the count it reads
+        pendingBytes_ += size;
+        sequence = ++appended_;
+    }
+    logBytes_ += size;
+
+    if (options_.waitForDurable) {
+        // Group commit: everyone who appends while a write is in progress
+        // shares the next fsync
+        std::unique_lock<std::mutex> lock(mutex_);
+        syncRequested_ = true;
+        flushWanted_.notify_one();
+        flushed_.wait(lock, [&] { return durable_ >= sequence || failed_; });
+        if (durable_ < sequence) return 0;
+    } else if (pendingBytes_ >= options_.maxBatchBytes) {
+        // without mutex_ a wakeup can be missed; the flusher then writes on its interval
+        flushWanted_.notify_one();
+    }
+    return sequence;
+}
+
+bool WriteAheadLog::sync() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!flusher_.joinable()) return false;
+
+    uint64_t target = appended_;
+    syncRequested_ = true;
+    flushWanted_.notify_one();
+    flushed_.wait(lock, [&] { return durable_ >= target || failed_; });
+    return durable_ >= target;
+}
+
+uint64_t WriteAheadLog::getAppendedCount() const {
+    return appended_;
+}
+
+uint64_t WriteAheadLog::getDurableCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return durable_;
+}
+
+uint64_t WriteAheadLog::getLogBytes() const {
+    return logBytes_;
+}
+
+// Move every lane's records into `batch`, one lane lock at a time
+size_t WriteAheadLog::collectLanes(std::vector<char>& batch) {
+    for (Lane& lane : lanes_) {
+        std::lock_guard<std::mutex> laneLock(lane.mutex);
+        if (lane.pending.empty()) continue;
+        batch.insert(batch.end(), lane.pending.begin(), lane.pending.end());
+        pendingBytes_ -= lane.pending.size();
+        lane.pending.clear();
+    }
+    return batch.size();
+}
+
+// Background writer. Collects everything pending, writes and fsyncs it without
+// the lock held, so appends carry on into the lanes meanwhile.
+void WriteAheadLog::flushLoop() {
+    std::vector<char> batch;
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+        flushWanted_.wait_for(lock, std::chrono::milliseconds(options_.flushIntervalMs), [this] {
+            return stopping_ || syncRequested_ || pendingBytes_ >= options_.maxBatchBytes;
+        });
+
+        // After a failure, records would land behind a gap; drop them instead
+        if (failed_) {
+            collectLanes(batch);
+            batch.clear();
+            syncRequested_ = false;
+            flushed_.notify_all();
+            if (stopping_) return;
+            continue;
+        }
+
+        // Every record counted so far is already in a lane or written
+        uint64_t upTo = appended_;
+        if (pendingBytes_ == 0) {
+            if (syncRequested_) {
+                syncRequested_ = false;
+                durable_ = upTo;  // nothing left unwritten
+                flushed_.notify_all();
+            }
+            if (stopping_) return;
+            continue;
+        }
+
+        int fd = fd_;
+        syncRequested_ = false;
+        flushing_ = true;
+
+        lock.unlock();
+        collectLanes(batch);
+        sealFrames(batch);
+        bool written = writeAll(fd, batch.data(), batch.size()) && ::fsync(fd) == 0;
+        batch.clear();
+        lock.lock();
+
+        flushing_ = false;
+        if (written) durable_ = upTo;
+        else failed_ = true;
+        flushed_.notify_all();
+    }
+}
+
+bool WriteAheadLog::beginSnapshot() {
+    if (fd_ < 0 || !sync()) return false;
+
+    std::string temporary = directory_ + "/snapshot.bin.tmp";
+    snapshotFd_ = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (snapshotFd_ < 0) return false;
+
+    std::vector<char> head = header(generation_ + 1);
+    snapshotFailed_ = !writeAll(snapshotFd_, head.data(), head.size());
+    snapshotBuffer_.clear();
+    return true;
+}
+
+void WriteAheadLog::writeSnapshotRecord(const JournalRecord& record) {
+    encode(record, snapshotBuffer_);
+    if (snapshotBuffer_.size() >= options_.maxBatchBytes) {
+        flushSnapshotBuffer();
+    }
+}
+
+void WriteAheadLog::flushSnapshotBuffer() {
+    sealFrames(snapshotBuffer_);
+    snapshotFailed_ |= !writeAll(snapshotFd_, snapshotBuffer_.data(), snapshotBuffer_.size());
+    snapshotBuffer_.clear();
+}
+
+bool WriteAheadLog::finishSnapshot() {
+    flushSnapshotBuffer();
+    bool written = !snapshotFailed_ && ::fsync(snapshotFd_) == 0;
+    ::close(snapshotFd_);
+    snapshotFd_ = -1;
+    std::vector<char>().swap(snapshotBuffer_);
+
+    std::string temporary = directory_ + "/snapshot.bin.tmp";
+    if (!written || ::rename(temporary.c_str(), (directory_ + "/snapshot.bin").c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    syncDirectory(directory_);
+
+    // From here recovery ignores the old log, so its records must not be written again
+    std::unique_lock<std::mutex> lock(mutex_);
+    flushed_.wait(lock, [this] { return !flushing_; });
+    for (Lane& lane : lanes_) {
+        std::lock_guard<std::mutex> laneLock(lane.mutex);
+        lane.pending.clear();
+    }
+    pendingBytes_ = 0;
+    if (!startLog(generation_ + 1)) {
+        failed_ = true;  // appends would go to a log that recovery now skips
+        return false;
+    }
+    return true;
+}
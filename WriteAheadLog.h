@@ -0,0 +1,150 @@
+// WriteAheadLog.h
+// Durable journal for BankingSystem. Every balance change is appended to an
+// in-memory batch and a background thread writes the batch out and fsyncs it
+// (group commit): one fsync covers every record appended since the last one,
+// so deposits and withdrawals only pay for encoding a few dozen bytes.
+// Appends go to one of several lanes picked by account, each with its own
+// lock, so accounts don't queue behind each other; the background thread
+// collects the lanes when it writes. An account's records always share a lane
+// and stay in order; records of different accounts are independent.
+//
+// The directory holds two files:
+//   journal.log    records appended since the last compaction
+//   snapshot.bin   the full state of every account at the last compaction
+// Both start with a header carrying a generation number. Compaction writes a
+// snapshot of generation g+1 and then restarts the log as generation g+1, so a
+// crash between the two steps leaves a log that recovery knows to skip.
+// Records are framed with their length and a CRC32; a torn record at the end of
+// the log (a crash mid-write) is dropped on recovery.
+// A failed write or fsync is final: nothing more is written, since later
+// records would follow a gap, and append() and sync() report the failure.
+
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+struct JournalOptions {
+    int flushIntervalMs = 5;                  // longest a record waits before it is written
+    size_t maxBatchBytes = 1 << 20;           // write early once this much is pending
+    bool waitForDurable = false;              // append() returns only once the record is on disk
+    uint64_t compactAfterBytes = 64ull << 20; // log size at which needsCompaction() turns true
+};
+
+// One journal entry. Text fields are views: when appending they only need to
+// live for the call, and during recovery they point into the file being read.
+struct JournalRecord {
+    enum Kind : uint8_t {
+        OPEN_ACCOUNT = 1,  // older logs only: like ACCOUNT with the plaintext password
+        RESET = 2,         // history and schedules cleared, balance set to amount
+        TRANSACTION = 3,   // balance changed by amount (signed), entry added to history
+        HISTORY = 4,       // entry added to history only (snapshots)
+        ACCOUNT = 5        // new account: username, password hash, balance in amount
+    };
+
+    Kind kind;
+    uint32_t account;      // id given to the account when it was opened
+    int64_t amount;        // Money micro-units
+    uint8_t type;          // Transaction::Type
+    int32_t day;
+    int64_t timestamp;     // microseconds since the epoch
+    std::string_view username;
+    std::string_view password;   // PasswordHash::bytes() for ACCOUNT
+    std::string_view description;
+};
+
+class WriteAheadLog {
+public:
+    WriteAheadLog(const std::string& directory, const JournalOptions& options = JournalOptions());
+    ~WriteAheadLog();  // writes out anything still pending
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Replay the snapshot and then the log through apply(), oldest first, and
+    // start accepting appends. Returns false if the directory can't be used.
+    bool open(const std::function<void(const JournalRecord&)>& apply);
+
+    bool isOpen() const { return fd_ >= 0; }
+    const std::string& getDirectory() const { return directory_; }
+
+    // Queue a record; safe from any thread. Returns its sequence number, or 0
+    // once the log has failed (with waitForDurable, if it failed before the
+    // record reached the disk).
+    uint64_t append(const JournalRecord& record);
+
+    // Block until every record appended so far is on disk. False if the log
+    // has failed, so some of them never will be.
+    bool sync();
+
+    bool hasFailed() const { return failed_; }
+
+    uint64_t getAppendedCount() const;
+    uint64_t getDurableCount() const;
+    uint64_t getLogBytes() const;
+    bool needsCompaction() const { return getLogBytes() >= options_.compactAfterBytes; }
+
+    // Replace the snapshot with the current state and empty the log.
+    // writeState(writeRecord) must call writeRecord(record) for every account (ACCOUNT
+    // followed by its HISTORY). Nothing may change account state meanwhile:
+    // a change made during compaction could be counted twice or lost on recovery.
+    template <typename WriteState>
+    bool compact(WriteState writeState) {
+        if (!beginSnapshot()) return false;
+        writeState([this](const JournalRecord& record) { writeSnapshotRecord(record); });
+        return finishSnapshot();
+    }
+
+private:
+    bool startLog(uint64_t generation);  // mutex_ held or flusher not running, no appends
+    bool beginSnapshot();
+    void writeSnapshotRecord(const JournalRecord& record);
+    void flushSnapshotBuffer();
+    bool finishSnapshot();
+    void flushLoop();
+
+    static const size_t kLaneCount = 64;
+
+    // Encoded records not yet handed to the flusher
+    struct alignas(64) Lane {
+        std::mutex mutex;
+        std::vector<char> pending;
+    };
+
+    size_t collectLanes(std::vector<char>& batch);
+
+    std::string directory_;
+    JournalOptions options_;
+    int fd_;                        // journal.log
+    uint64_t generation_;
+
+    Lane lanes_[kLaneCount];
+    std::atomic<uint64_t> appended_;      // records appended, counted under their lane's lock
+    std::atomic<uint64_t> pendingBytes_;  // bytes sitting in the lanes
+    std::atomic<uint64_t> logBytes_;
+    std::atomic<bool> failed_;            // a write failed; set with mutex_ held
+
+    mutable std::mutex mutex_;      // guards everything below
+    std::condition_variable flushWanted_;
+    std::condition_variable flushed_;
+    uint64_t durable_;              // records known to be on disk
+    bool flushing_;                 // the flusher is writing outside the lock
+    bool syncRequested_;            // someone is waiting; flush without waiting for the interval
+    bool stopping_;
+    std::thread flusher_;
+
+    // Snapshot being written by compact()
+    int snapshotFd_;
+    std::vector<char> snapshotBuffer_;
+    bool snapshotFailed_;
+};
+
+#endif // WRITEAHEADLOG_H
@@ -0,0 +1,14 @@
+# Micro-benchmarks for the simulation engine (no Qt)
+
+TEMPLATE = app
+TARGET = SimulationBench
+CONFIG += console c++17 release
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    main.cpp
+
+LIBS += -L$$OUT_PWD/../engine -lSimulationEngine
+PRE_TARGETDEPS += $$OUT_PWD/../engine/libSimulationEngine.a
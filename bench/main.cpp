@@ -0,0 +1,356 @@
+// bench/main.cpp
+// Micro-benchmarks for the simulator hot paths. Prints one JSON object per
+// line (benchmark, tickers, iterations, ns_per_op) so results can be diffed
+// between changes.
+//
+// Usage: SimulationBench [sizes=14,1000,100000] [min_time=0.2]
+
+#include "BankingTradingFacade.h"
+#include "SimulationCheckpoint.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+double minSeconds = 0.2;
+
+// Call op repeatedly until at least minSeconds have passed, then print the average cost
+// of one operation (each call of op performs opsPerCall of them)
+void runBenchmark(const std::string& name, long tickers, const std::function<void()>& op,
+                  long opsPerCall = 1) {
+    using Clock = std::chrono::steady_clock;
+
+    op();  // warm up
+
+    long iterations = 0;
+    long batch = 1;
+    double elapsed = 0.0;
+    Clock::time_point start = Clock::now();
+
+    while (elapsed < minSeconds) {
+        for (long i = 0; i < batch; i++) {
+            op();
+        }
+        iterations += batch;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (batch < (1L << 20)) batch *= 2;
+    }
+
+    std::printf("{\"benchmark\":\"%s\",\"tickers\":%ld,\"iterations\":%ld,\"ns_per_op\":%.1f}\n",
+                name.c_str(), tickers, iterations * opsPerCall, elapsed * 1e9 / (iterations * opsPerCall));
+    std::fflush(stdout);
+}
+
+std::vector<StockListing> makeUniverse(long count) {
+    RandomSource rng(count);
+    std::vector<StockListing> listings;
+    listings.reserve(count);
+
+    char symbol[32];
+    for (long i = 0; i < count; i++) {
+        std::snprintf(symbol, sizeof(symbol), "SYM%06ld", i);
+        listings.push_back({symbol, symbol, 5.0 + rng.nextInt(50000) / 100.0});
+    }
+    return listings;
+}
+
+std::vector<long> parseSizes(const std::string& text) {
+    std::vector<long> sizes;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t comma = text.find(',', start);
+        if (comma == std::string::npos) comma = text.size();
+        long size = std::atol(text.substr(start, comma - start).c_str());
+        if (size > 0) sizes.push_back(size);
+        start = comma + 1;
+    }
+    return sizes;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    std::vector<long> sizes = {14, 100, 1000, 10000, 100000};
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.rfind("sizes=", 0) == 0) {
+            sizes = parseSizes(arg.substr(6));
+        } else if (arg.rfind("min_time=", 0) == 0) {
+            minSeconds = std::atof(arg.c_str() + 9);
+        } else {
+            std::fprintf(stderr, "Usage: %s [sizes=14,1000,...] [min_time=seconds]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    // --- Size-independent paths ---
+
+    SimpleStockFactory factory;
+    StockPriceGenerator* generator = factory.createPriceGenerator();
+    RandomSource rng(1);
+    double price = 100.0;
+    runBenchmark("StockPriceGenerator::generate", 1, [&]() {
+        price = generator->generate(price, rng);
+        if (price < 1.0 || price > 1e6) price = 100.0;
+    });
+    delete generator;
+
+    // Ten years of daily closes in one compressed series: encoding a point, and
+    // decoding the whole range (ns_per_op is per decoded point)
+    const int historyDays = 2520;
+    std::vector<double> closes(historyDays);
+    closes[0] = 100.0;
+    for (int d = 1; d < historyDays; d++) {
+        closes[d] = std::max(1.0, closes[d - 1] * (1.0 + (rng.nextInt(2001) - 1000) / 50000.0));
+    }
+    CompressedSeries series;
+    int seriesDay = 0;
+    runBenchmark("CompressedSeries::append", 1, [&]() {
+        if (seriesDay == historyDays) {
+            series.clear();
+            seriesDay = 0;
+        }
+        series.append(seriesDay, closes[seriesDay]);
+        seriesDay++;
+    });
+    series.clear();
+    for (int d = 0; d < historyDays; d++) {
+        series.append(d, closes[d]);
+    }
+    std::vector<int> rangeDays;
+    std::vector<double> rangeValues;
+    runBenchmark("CompressedSeries::getRange", 1, [&]() {
+        rangeDays.clear();
+        rangeValues.clear();
+        series.getRange(0, historyDays - 1, rangeDays, rangeValues);
+    }, historyDays);
+
+    BankingSystem& bank = BankingSystem::getInstance();
+    bank.registerUser("bench", "bench", Money::units(1000000000000));
+    bank.login("bench", "bench");
+    int day = 1;
+    runBenchmark("BankingSystem::deposit+withdraw", 0, [&]() {
+        bank.deposit(Money::units(10), "Bench deposit", day);
+        bank.withdraw(Money::units(10), "Bench withdraw", day);
+    });
+    bank.resetCurrentAccount(Money::units(1000000000000));
+
+    // Many threads, each on its own accounts (measures contention between unrelated accounts)
+    unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    const long opsPerThread = 1000;
+    std::vector<AccountHandle> sessions;
+    for (unsigned t = 0; t < threads * 16; t++) {
+        bank.registerUser("bench" + std::to_string(t), "", Money::units(1000000000000));
+        sessions.push_back(bank.openSession("bench" + std::to_string(t), ""));
+    }
+    runBenchmark("AccountHandle::deposit+withdraw/" + std::to_string(threads) + "threads", 0, [&]() {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&sessions, t, opsPerThread]() {
+                for (long i = 0; i < opsPerThread; i++) {
+                    AccountHandle& session = sessions[t * 16 + i % 16];
+                    session.deposit(Money::units(10), "Bench deposit", 1);
+                    session.withdraw(Money::units(10), "Bench withdraw", 1);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }, threads * opsPerThread);
+    for (auto& session : sessions) {
+        session.reset(Money::units(1000000000000));
+    }
+
+    // Same operations with the write-ahead log on: background group commit, and
+    // every thread waiting for its records to reach disk
+    char journalDir[] = "/tmp/SimulationBenchXXXXXX";
+    if (mkdtemp(journalDir)) {
+        {
+            BankingSystem journaled;
+            journaled.openJournal(journalDir);
+            journaled.registerUser("bench", "", Money::units(1000000000000));
+            AccountHandle session = journaled.openSession("bench", "");
+            runBenchmark("BankingSystem::deposit+withdraw/journal", 0, [&]() {
+                session.deposit(Money::units(10), "Bench deposit", 1);
+                session.withdraw(Money::units(10), "Bench withdraw", 1);
+            });
+            journaled.syncJournal();
+        }
+        {
+            JournalOptions options;
+            options.waitForDurable = true;
+            BankingSystem journaled;
+            journaled.openJournal(std::string(journalDir) + "/durable", options);
+            std::vector<AccountHandle> durableSessions;
+            for (unsigned t = 0; t < threads; t++) {
+                journaled.registerUser("bench" + std::to_string(t), "", Money::units(1000000000000));
+                durableSessions.push_back(journaled.openSession("bench" + std::to_string(t), ""));
+            }
+            const long durableOps = 20;
+            runBenchmark("AccountHandle::deposit/journal-durable/" + std::to_string(threads) + "threads", 0, [&]() {
+                std::vector<std::thread> workers;
+                for (unsigned t = 0; t < threads; t++) {
+                    workers.emplace_back([&durableSessions, t, durableOps]() {
+                        for (long i = 0; i < durableOps; i++) {
+                            durableSessions[t].deposit(Money::units(10), "Bench deposit", 1);
+                        }
+                    });
+                }
+                for (auto& worker : workers) {
+                    worker.join();
+                }
+            }, threads * durableOps);
+        }
+        std::error_code ignored;
+        std::filesystem::remove_all(journalDir, ignored);
+    }
+
+    // Restore a 1,000-account bank (500 transactions each) from a loaded checkpoint
+    {
+        BankingSystem warm;
+        StockMarket warmMarket(1);
+        for (int a = 0; a < 1000; a++) {
+            std::string name = "acct" + std::to_string(a);
+            warm.registerUser(name, "", Money::units(10000));
+            AccountHandle session = warm.getAccount(name);
+            for (int t = 0; t < 500; t++) {
+                session.deposit(Money::units(1), t % 2 ? "Sell GOOG" : "Buy NVDA", t);
+            }
+        }
+        SimulationCheckpoint checkpoint = SimulationCheckpoint::capture(warmMarket, {}, warm);
+
+        BankingSystem branch;
+        StockMarket branchMarket(2);
+        runBenchmark("SimulationCheckpoint::restore/1000accounts", 0, [&]() {
+            checkpoint.restore(branchMarket, {}, branch);
+        });
+    }
+
+    // --- Paths that scale with the universe ---
+
+    BankingTradingFacade& facade = BankingTradingFacade::getInstance();
+    TradingBot bot(bank, 1);  // standalone bot trading for the logged-in bench account
+    AggressiveStrategy aggressive;
+    ConservativeStrategy conservative;
+
+    for (long tickers : sizes) {
+        std::vector<StockListing> universe = makeUniverse(tickers);
+
+        // load the universe from a file, as SimulationCli does for universe=<file>
+        char universeFile[] = "/tmp/SimulationBenchUniverseXXXXXX";
+        int universeFd = mkstemp(universeFile);
+        if (universeFd >= 0) {
+            FILE* file = fdopen(universeFd, "w");
+            std::fprintf(file, "symbol,name,price\n");
+            for (const StockListing& listing : universe) {
+                std::fprintf(file, "%s,%s,%.2f\n", listing.ticker_symbol.c_str(), listing.name.c_str(),
+                             listing.openingPrice);
+            }
+            std::fclose(file);
+
+            StockMarket market(1);
+            runBenchmark("StockMarket::readUniverseFile+loadUniverse", tickers, [&]() {
+                std::vector<StockListing> listings;
+                std::string error;
+                StockMarket::readUniverseFile(universeFile, listings, error);
+                market.loadUniverse(listings);
+            });
+            std::remove(universeFile);
+        }
+
+        // a market day plus recording its closes (history restarts every year to bound memory)
+        {
+            StockMarket market(1);
+            market.loadUniverse(universe);
+            TimeSeriesStore history;
+            int recordedDays = 0;
+            runBenchmark("StockMarket::advanceDay+TimeSeriesStore::recordPrices", tickers, [&]() {
+                if (++recordedDays == 252) {
+                    history.clear();
+                    recordedDays = 0;
+                }
+                market.advanceDay();
+                history.recordPrices(market);
+            });
+        }
+
+        bot.loadUniverse(universe);
+        bot.reset();
+        bank.resetCurrentAccount(Money::units(10000000));
+        bot.setStrategy("Conservative");
+        bot.startBot();
+        bot.advanceDay();
+
+        runBenchmark("TradingBot::advanceDay", tickers, [&]() {
+            bot.advanceDay();
+        });
+
+        StockTable stocks = bot.getAllStocks();
+        double balance = bot.getAvailableBalance().toDouble();
+        runBenchmark("AggressiveStrategy::rankStocks", tickers, [&]() {
+            std::vector<StockRanks> ranks = aggressive.rankStocks(stocks, balance);
+        });
+        runBenchmark("ConservativeStrategy::rankStocks", tickers, [&]() {
+            std::vector<StockRanks> ranks = conservative.rankStocks(stocks, balance);
+        });
+
+        // the scoring pass alone, with each kernel this CPU can run
+        std::string defaultKernel = getScoringKernel();
+        std::vector<double> scores(tickers);
+        std::vector<int32_t> shares(tickers), picks(tickers);
+        for (const char* kernel : {"scalar", "avx2", "avx512"}) {
+            if (!setScoringKernel(kernel)) continue;
+            runBenchmark(std::string("scoreStocks/") + kernel, tickers, [&]() {
+                scoreStocks(stocks.curPrices(), stocks.prevPrices(), stocks.size(), PriceMove::UP, balance * 0.25,
+                            scores.data(), shares.data(), picks.data());
+            });
+        }
+        setScoringKernel(defaultKernel.c_str());
+
+        runBenchmark("TradingBot::executeTradingCycle", tickers, [&]() {
+            bot.executeTradingCycle();
+        });
+
+        // plan each pass from a fresh balance, as a trading cycle would. Nothing
+        // is settled, so every call sees the same portfolio and takes the same path.
+        Money planningBalance = bot.getAvailableBalance();
+        runBenchmark("TradingBot::checkSells", tickers, [&]() {
+            bot.beginOrders(planningBalance);
+            bot.checkSells();
+        });
+
+        // buys from an empty portfolio, so each pass queues real orders up to maxHoldings
+        bot.liquidateAll();
+        planningBalance = bot.getAvailableBalance();
+        runBenchmark("TradingBot::checkBuys", tickers, [&]() {
+            bot.beginOrders(planningBalance);
+            bot.checkBuys();
+        });
+        bot.beginOrders(Money());
+
+        // the facade runs its own bot on its own market; give it some history first
+        std::string error;
+        facade.resetSimulation(Money::units(10000000));
+        facade.loadUniverse(universe, error);
+        facade.startBot();
+        facade.advanceDays(20);
+        runBenchmark("BankingTradingFacade::getPerformance", tickers, [&]() {
+            BankingTradingFacade::PerformanceSummary summary = facade.getPerformance();
+            (void)summary;
+        });
+
+        facade.stopBot();
+        bot.stopBot();
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+# Command-line batch simulation runner (no Qt)
+
+TEMPLATE = app
+TARGET = SimulationCli
+CONFIG += console c++17
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    main.cpp
+
+LIBS += -L$$OUT_PWD/../engine -lSimulationEngine
+PRE_TARGETDEPS += $$OUT_PWD/../engine/libSimulationEngine.a
@@ -0,0 +1,73 @@
+// cli/main.cpp
+// Command-line runner for headless batch simulations (no Qt required).
+//
+// Usage: SimulationCli [--config file] [key=value ...]
+//   keys: mode, universe, strategy, seed, days, accounts, simulations, threads, balance, output
+//   sweep keys: strategies, take_profit, stop_loss, max_holdings, paths, top
+//   tournament keys: entries, top
+
+#include "SimulationRunner.h"
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char *argv[]) {
+    SimulationConfig config;
+    std::string error;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+
+        if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [--config file] [key=value ...]\n"
+                      << "  mode=accounts|montecarlo|sweep|tournament\n"
+                      << "  universe=default|<ticker count>|<file>\n"
+                      << "  strategy=auto|aggressive|conservative\n"
+                      << "  seed=<n> days=<n> accounts=<n> balance=<amount>\n"
+                      << "  simulations=<n> threads=<n> (montecarlo mode)\n"
+                      << "  strategies=<list> take_profit=<a:b:step|list> stop_loss=<...>\n"
+                      << "  max_holdings=<...> paths=<n> top=<n> threads=<n> (sweep mode)\n"
+                      << "  entries=<strategy[:take_profit:stop_loss:max_holdings],...> top=<n>\n"
+                      << "  threads=<n> (tournament mode)\n"
+                      << "  output=<csv file> (default: stdout)\n";
+            return 0;
+        }
+
+        if (arg == "--config") {
+            if (i + 1 >= argc) {
+                std::cerr << "--config needs a file name\n";
+                return 1;
+            }
+            if (!SimulationRunner::loadConfigFile(config, argv[++i], error)) {
+                std::cerr << error << "\n";
+                return 1;
+            }
+        } else if (!SimulationRunner::applySetting(config, arg, error)) {
+            std::cerr << error << "\n";
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!config.output.empty()) {
+        file.open(config.output);
+        if (!file) {
+            std::cerr << "Cannot write " << config.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = config.output.empty() ? std::cout : file;
+
+    SimulationRunner runner;
+    if (config.mode == "montecarlo") {
+        MonteCarloEngine::writeSummaryCsv(out, runner.runMonteCarlo(config));
+    } else if (config.mode == "sweep") {
+        ParameterSweep::writeCsv(out, runner.runSweep(config), config.top);
+    } else if (config.mode == "tournament") {
+        Tournament::writeCsv(out, runner.runTournament(config), config.top);
+    } else {
+        SimulationRunner::writeCsv(out, runner.run(config));
+    }
+
+    return 0;
+}
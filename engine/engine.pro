@@ -0,0 +1,8 @@
+# Headless simulation engine as a static library (no Qt)
+
+TEMPLATE = lib
+TARGET = SimulationEngine
+CONFIG += staticlib c++17
+CONFIG -= qt
+
+include(../SimulationEngine.pri)
@@ -1,10 +1,26 @@
 // main.cpp
 #include <QApplication>
+#include <QDir>
+#include <QMessageBox>
+#include <QStandardPaths>
 #include "MainWindow.h"
+#include "BankingTradingFacade.h"
 
 int main(int argc, char *argv[]) {
     QApplication app(argc, argv);
     
+    // Accounts are kept in the user's data directory between runs
+    QString dataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dataDir);
+    if (!BankingTradingFacade::getInstance().openJournal(QDir(dataDir).filePath("bank").toStdString())) {
+        QMessageBox::warning(nullptr, "Storage",
+                             "Could not open the account journal in " + dataDir +
+                             ". Changes made in this session will not be saved.");
+    }
+    
+    // Keep the closing prices of every day played, for charts and exports
+    BankingTradingFacade::getInstance().setPriceHistoryEnabled(true);
+    
     MainWindow window;
     window.show();
     